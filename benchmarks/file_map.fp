@@ -0,0 +1,23 @@
+import "io"
+import "file"
+import "string"
+
+// Counts the lines of a file through file_map. The path is read from
+// stdin, since there are no program arguments yet:
+//   echo big.log | ./file_map
+// Compare with `wc -l big.log`. The timing goes to stderr.
+new path = read_line()
+new began = wtime()
+new fd = file_open(path, "r")
+new text = file_map(fd)
+file_sequential(text)
+new lines = str_count(text, "\n")
+file_unmap(text)
+file_close(fd)
+new elapsed = wtime() - began
+
+printf("%ld lines\n", lines)
+new report = writer_new(2, 0)
+write_str(report, "file_map  ")
+write_int(report, (i64) (elapsed * 1000.0))
+write_str(report, " ms\n")
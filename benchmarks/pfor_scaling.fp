@@ -0,0 +1,26 @@
+import "io"
+import "parallel"
+
+// Integrates 4 / (1 + x^2) over [0, 1] on 1, 2, ... N threads.
+// FARPY_THREADS sets N; it defaults to the number of online CPUs.
+new steps = 50000000
+new width: float = 1.0 / steps
+new cores = parallel_threads()
+new mut base: float = 0.0
+
+for 1..=cores -> threads {
+    parallel_set_threads(threads)
+
+    new mut sum: float = 0.0
+    new began = parallel_wtime()
+    pfor 0..steps -> i reduce + sum {
+        new x: float = (i + 0.5) * width
+        sum = sum + 4.0 / (1.0 + x * x)
+    }
+    new elapsed = parallel_wtime() - began
+
+    if threads == 1 {
+        base = elapsed
+    }
+    printf("%2d threads  %.3fs  %.2fx  pi = %.12f\n", threads, elapsed, base / elapsed, sum * width)
+}
@@ -0,0 +1,17 @@
+import "io"
+import "string"
+
+// Reads all of stdin at once and counts its newlines. Compare
+//   ./read_all < big.log        (the file is mapped)
+//   cat big.log | ./read_all    (read into one growing buffer)
+// The counts go to stdout and the timing to stderr.
+new began = wtime()
+new input = read_all()
+new lines = str_count(input, "\n")
+new elapsed = wtime() - began
+
+printf("%ld newlines, %ld bytes\n", lines, slice_len(input))
+new report = writer_new(2, 0)
+write_str(report, "read_all  ")
+write_int(report, (i64) (elapsed * 1000.0))
+write_str(report, " ms\n")
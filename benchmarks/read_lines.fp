@@ -0,0 +1,23 @@
+import "io"
+import "string"
+
+// Counts the lines and bytes on stdin with the line reader. Compare
+//   ./read_lines < big.log        (the file is mapped)
+//   cat big.log | ./read_lines    (read in 256 KB blocks)
+// The counts go to stdout and the timing to stderr.
+new began = wtime()
+new input = lines_new(0)
+new mut lines: i64 = 0
+new mut bytes: i64 = 0
+while lines_next(input) {
+    bytes = bytes + slice_len(lines_view(input))
+    lines = lines + 1
+}
+lines_close(input)
+new elapsed = wtime() - began
+
+printf("%ld lines, %ld bytes\n", lines, bytes)
+new report = writer_new(2, 0)
+write_str(report, "lines_next  ")
+write_int(report, (i64) (elapsed * 1000.0))
+write_str(report, " ms\n")
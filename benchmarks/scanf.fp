@@ -0,0 +1,19 @@
+import "io"
+
+// The scanf baseline for benchmarks/scanner.fp, on the same input
+new began = wtime()
+new mut a: i64 = 0
+new mut b = 0.0
+new mut ints: i64 = 0
+new mut floats = 0.0
+while scanf("%ld %lf", &a, &b) == 2 {
+    ints = ints + a
+    floats = floats + b
+}
+new elapsed = wtime() - began
+
+printf("%ld %.17g\n", ints, floats)
+new report = writer_new(2, 0)
+write_str(report, "scanf  ")
+write_int(report, (i64) (elapsed * 1000.0))
+write_str(report, " ms\n")
@@ -0,0 +1,23 @@
+import "io"
+
+// Reads "<int> <double>" pairs from stdin with the scanner. Make the input
+// with the writer benchmark (./writer > numbers.txt) and compare
+//   ./scanner < numbers.txt
+//   ./scanf < numbers.txt
+// The sums go to stdout and the timing to stderr.
+new began = wtime()
+new input = scanner_new(0)
+new mut ints: i64 = 0
+new mut floats = 0.0
+while has_next(input) {
+    ints = ints + next_i64(input)
+    floats = floats + next_f64(input)
+}
+scanner_close(input)
+new elapsed = wtime() - began
+
+printf("%ld %.17g\n", ints, floats)
+new report = writer_new(2, 0)
+write_str(report, "scanner  ")
+write_int(report, (i64) (elapsed * 1000.0))
+write_str(report, " ms\n")
@@ -0,0 +1,30 @@
+import "io"
+import "string"
+import "memory"
+
+// Builds a 10^5 byte string one append at a time, first by re-concatenating
+// with strcat (quadratic: every append copies the whole string) and then
+// with a string builder.
+new appends = 100000
+
+new mut began = wtime()
+new mut s = strcat("", "")
+for 0..appends -> i {
+    new next = strcat(s, "x")
+    free(s)
+    s = next
+}
+new concat_time = wtime() - began
+
+began = wtime()
+new sb = sb_new(0)
+for 0..appends -> i {
+    sb_append(sb, "x")
+}
+new built = sb_finish(sb)
+new builder_time = wtime() - began
+
+printf("strcat   %.4fs  %d bytes\n", concat_time, str_length(s))
+printf("builder  %.4fs  %d bytes  %.0fx faster\n", builder_time, str_length(built), concat_time / builder_time)
+free(s)
+free(built)
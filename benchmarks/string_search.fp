@@ -0,0 +1,48 @@
+import "io"
+import "string"
+import "memory"
+
+// Scans ~66 MB of log lines and reports throughput in GB/s. The needles
+// are not in the text, so every byte is looked at. view_find (memchr on
+// the first byte, then memcmp) is the baseline for str_find.
+new sb = sb_new(0)
+for 0..800000 -> i {
+    sb_append(sb, "2025-01-01T12:00:00Z INFO request served path=/api/v1/items status=200 bytes=5120\n")
+}
+new text = sb_finish(sb)
+new reps = 10
+new gigabytes: float = str_length(text) * reps / 1000000000.0
+new mut misses: i64 = 0
+
+new mut began = wtime()
+for 0..reps -> i {
+    misses = misses + view_find(text, "status=500")
+}
+printf("view_find         %6.2f GB/s\n", gigabytes / (wtime() - began))
+
+began = wtime()
+for 0..reps -> i {
+    misses = misses + str_find(text, "status=500")
+}
+printf("str_find          %6.2f GB/s\n", gigabytes / (wtime() - began))
+
+began = wtime()
+for 0..reps -> i {
+    misses = misses + str_rfind(text, "status=500")
+}
+printf("str_rfind         %6.2f GB/s\n", gigabytes / (wtime() - began))
+
+began = wtime()
+for 0..reps -> i {
+    misses = misses + str_find_any(text, "#|;")
+}
+printf("str_find_any      %6.2f GB/s\n", gigabytes / (wtime() - began))
+
+began = wtime()
+for 0..reps -> i {
+    misses = misses + str_count(text, "status=200")
+}
+printf("str_count         %6.2f GB/s\n", gigabytes / (wtime() - began))
+
+printf("(%ld)\n", misses)
+free(text)
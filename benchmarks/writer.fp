@@ -0,0 +1,30 @@
+import "io"
+
+// Prints 2 * 10^6 lines of "<int> <float>" with printf and then with a
+// buffered writer. Run it with stdout redirected (> /dev/null); the
+// timings go to stderr.
+new lines = 2000000
+
+new mut began = wtime()
+for 0..lines -> i {
+    printf("%d %.17g\n", i, i * 0.25)
+}
+new printf_time = wtime() - began
+
+began = wtime()
+new out = writer_new(1, 0)
+for 0..lines -> i {
+    write_int(out, i)
+    write_char(out, 32)
+    write_f64(out, i * 0.25)
+    write_char(out, 10)
+}
+flush(out)
+new writer_time = wtime() - began
+
+new report = writer_new(2, 0)
+write_str(report, "printf  ")
+write_int(report, (i64) (printf_time * 1000.0))
+write_str(report, " ms\nwriter  ")
+write_int(report, (i64) (writer_time * 1000.0))
+write_str(report, " ms\n")
@@ -20,8 +20,10 @@ const ARG_CONFIG = {
     "g",
     "dead-code",
     "repl",
+    "profiling",
+    "bounds-check",
   ],
-  string: ["output", "target"],
+  string: ["output", "target", "veclib"],
   default: { "output": "a.out" },
 };
 
@@ -49,6 +51,11 @@ OPTIONS:
   -o, --output=<file>     Specify output file name (default: a.out)
   --opt, --optimize       Enable optimization in AST
   --debug                 Enable debug mode
+  -g                      Emit DWARF debug info and keep symbols
+  --profiling             Like -g, and keep frame pointers for profilers
+  --bounds-check          Check array, vector and view indices at runtime
+  --veclib=<lib>          Vectorize math calls in loops with a SIMD libm
+                          (libmvec, SVML)
   --target=<target>       Specify target architecture (default: your architecture)
   --targeth               Show target architecture help
   --repl, --cli           Open the compiled repl mode`;
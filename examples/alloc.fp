@@ -0,0 +1,23 @@
+import "io"
+import "memory"
+
+struct Particle {
+    x: double;
+    y: double;
+    mass: double;
+    id: int;
+}
+
+// Sizes are folded at compile time: no strcmp, and structs get their
+// real size instead of a pointer's
+new counts = alloc_zeroed<i64>(16)
+new particles = alloc<Particle>(1000)
+new scores = alloc_zeroed<double>(4)
+new legacy = mnew("int")
+
+printf("%ld %.1f\n", *counts, *scores)
+
+free(counts)
+free(particles)
+free(scores)
+free(legacy)
@@ -0,0 +1,35 @@
+import "io"
+import "string"
+import "arena"
+
+// Everything built inside the region is released when it ends, including
+// on the early return
+fn greet(name: string): int
+{
+    region {
+        new greeting = strcat("hello, ", name)
+        printf("%s\n", greeting)
+        return str_length(greeting)
+    }
+    return 0
+}
+
+new mut total: int = 0
+for 0..1000 -> i {
+    region {
+        new word = strcat("farpy", str_slice("-arena", 0, 4))
+        total = total + str_length(word)
+    }
+}
+
+new a = arena_new(0)
+arena_alloc(a, 100)
+new previous = arena_use(a)
+new joined = strcat("ab", "cd")
+arena_use(previous)
+printf("%s %ld\n", joined, arena_used(a))
+arena_reset(a)
+printf("%ld\n", arena_used(a))
+arena_free(a)
+
+printf("%d %d\n", greet("region"), total)
@@ -0,0 +1,30 @@
+import "io"
+import "atomic"
+import "parallel"
+
+new mut hits: atomic<int> = 0
+new mut total: atomic<i64> = 0
+new mut peak: atomic<int> = 0
+
+pfor 0..10000 -> i {
+    atomic_fetch_add(hits, 1, relaxed)
+    atomic_fetch_add(total, i, relaxed)
+}
+
+// Running maximum with a compare-and-swap loop
+pfor 0..1000 -> i {
+    new v = (i * 37) % 1000
+    new mut current = atomic_load(peak, relaxed)
+    while current < v {
+        if atomic_cas(peak, current, v, acq_rel) {
+            current = v
+        } else {
+            current = atomic_load(peak, relaxed)
+        }
+    }
+}
+
+new counted = atomic_exchange(hits, 0, acq_rel)
+atomic_fence(seq_cst)
+
+printf("%d %ld %d %d\n", counted, atomic_load(total, acquire), atomic_load(peak, acquire), atomic_load(hits, relaxed))
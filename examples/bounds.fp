@@ -0,0 +1,30 @@
+import "io"
+import "string"
+import "vec"
+
+// Build with --bounds-check: `v[i]` is checked once before the loop
+// instead of on every iteration
+fn total(v: int[..], n: int): int
+{
+    new mut sum: int = 0
+    for 0..n -> i {
+        sum = sum + v[i]
+    }
+    return sum
+}
+
+new table: int[] = [3, 1, 4, 1, 5, 9, 2, 6]
+new mut values: int[..] = [10, 20, 30]
+new mut odd: int = 0
+
+for 0..8 -> i {
+    if table[i] % 2 == 1 {
+        odd = odd + table[i]
+    }
+}
+
+// Slices are checked too: 0 <= start <= end <= len
+new tail = slice(table, 5, 8)
+
+printf("%d %d %d %ld\n", odd, total(values, 3), table[7], slice_len(tail))
+vec_free(values)
@@ -0,0 +1,26 @@
+import "io"
+import "string"
+
+// A str carries its length: literals are measured at compile time, and
+// results shorter than 16 bytes are stored inline, without allocating
+fn greet(name: str): str
+{
+    return str_cat("hello, ", name)
+}
+
+new lit: str = "fat"
+new mut s = str_cat(lit, " strings")
+printf("%ld %s\n", str_len(s), s.cstr())
+
+s = greet("farpy")
+printf("%ld %s\n", str_len(s), s.cstr())
+
+new longer = str_cat(s, ", this one no longer fits inline")
+if view_ends_with(longer, "inline") {
+    printf("%ld\n", str_len(longer))
+}
+
+new plain = strcat("from ", "a C string")
+new copy = str_from(plain)
+print(copy.cstr())
+print("\n")
@@ -0,0 +1,41 @@
+import "io"
+import "file"
+import "string"
+import "memory"
+
+// Writes a file through a buffered writer, patches it in place and reads
+// it back through a map, a line reader and pread
+new path = "/tmp/farpy_file_example.txt"
+new fd = file_open(path, "w")
+new out = writer_new(fd, 0)
+for 1..4 -> i {
+    write_str(out, "line ")
+    write_int(out, i)
+    write_char(out, 10)
+}
+writer_close(out)
+file_close(fd)
+
+new rw = file_open(path, "r+")
+file_pwrite(rw, "LINE", 0)
+printf("%ld bytes\n", file_size(rw))
+
+new text = file_map(rw)
+file_sequential(text)
+view_print(text)
+file_unmap(text)
+
+new lines = lines_new(rw)
+new mut count: i64 = 0
+while lines_next(lines) {
+    count = count + 1
+}
+lines_close(lines)
+printf("%ld lines\n", count)
+
+// 16 zeroed bytes, so the text read stays terminated
+new buffer = alloc_zeroed<i64>(2)
+new got = file_pread(rw, buffer, 6, 7)
+printf("%ld: %s\n", got, buffer)
+free(buffer)
+file_close(rw)
@@ -0,0 +1,16 @@
+import "io"
+
+new LIMIT = 10
+new mut calls: int = 0
+// Escapes make the global shorter than the literal
+new HEADER = "scale\\n"
+
+fn scale(n: int): int
+{
+    calls = calls + 1
+    return n * LIMIT
+}
+
+print(HEADER)
+printf("%d\n", scale(4))
+printf("%d\n", calls)
@@ -0,0 +1,19 @@
+import "io"
+import "string"
+
+// Reads stdin line by line. Each line is a view into the reader's buffer
+// (or the mapped file), valid until the next lines_next()
+new input = lines_new(0)
+new out = writer_new(1, 0)
+new mut count: i64 = 0
+while lines_next(input) {
+    new line = lines_view(input)
+    write_int(out, slice_len(line))
+    write_char(out, 32)
+    write_str(out, line)
+    write_char(out, 10)
+    count = count + 1
+}
+lines_close(input)
+write_int(out, count)
+write_str(out, " lines\n")
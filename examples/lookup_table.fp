@@ -0,0 +1,16 @@
+import "io"
+
+new SQUARES: int[] = [0, 1, 4, 9, 16, 25]
+
+fn square(n: int): int
+{
+    return SQUARES[n]
+}
+
+fn pick(i: int): int
+{
+    new mut digits: int[] = [7, 8, 9]
+    return digits[i]
+}
+
+printf("%d %d\n", square(5), pick(2))
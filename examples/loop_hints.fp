@@ -0,0 +1,15 @@
+import "io"
+
+new mut sum: i32 = 0
+
+for 0..1000 -> i @unroll(4) {
+    sum = sum + i
+}
+
+new mut n: i32 = 0
+
+while n < 10 @nounroll {
+    n = n + 1
+}
+
+printf("%d %d\n", sum, n)
@@ -0,0 +1,12 @@
+import "io"
+import "math"
+
+// With --opt, calls on literals are evaluated at compile time
+new root2 = sqrt(2.0)
+new mut area: double = 0.0
+
+for 1..=100 -> i {
+    area = area + pi() * pow((double)i, 2.0)
+}
+
+printf("%.6f %.1f %.3f\n", root2, area / pi(), exp(log(8.0)))
@@ -0,0 +1,28 @@
+import "io"
+import "string"
+import "memory"
+
+// Parsers report through `stop` where the number ends: -1 when there is
+// none and -2 when it does not fit
+new mut stop: i64 = 0
+new csv = "-42,3.25e2,0.1,9223372036854775808,x"
+
+new a = parse_i64(csv, &stop)
+printf("%ld %ld\n", a, stop)
+new b = parse_f64(slice(csv, 4, 10), &stop)
+printf("%g %ld\n", b, stop)
+new c = parse_i64(slice(csv, 15, 34), &stop)
+printf("%ld %ld\n", c, stop)
+new d = parse_f64(slice(csv, 35, 36), &stop)
+printf("%g %ld\n", d, stop)
+
+// Formatters write into the caller's buffer and return the length
+new buf = alloc<i64>(4)   // 32 bytes
+new n = fmt_f64(buf, 32, 0.1 + 0.2)
+printf("%s %ld\n", buf, n)
+fmt_f64(buf, 32, 123456789.0 * 1000000000.0)
+printf("%s\n", buf)
+fmt_i64(buf, 32, -9000)
+printf("%s %ld\n", buf, fmt_i64(buf, 3, 12345))
+printf("%d\n", str_to_int("  2147483648"))
+free(buf)
@@ -0,0 +1,25 @@
+import "io"
+import "parallel"
+
+// `scale` is read by every thread; `total` gets one copy per chunk
+fn weighted(n: int, scale: float): float
+{
+    new mut total: float = 0.0
+    pfor 0..n -> i reduce + total {
+        total = total + i * scale
+    }
+    return total
+}
+
+new mut evens: i64 = 0
+new mut fact: i64 = 1
+
+pfor 0..=1000 step 2 -> i reduce + evens {
+    evens = evens + i
+}
+
+pfor 1..=15 -> i reduce * fact {
+    fact = fact * i
+}
+
+printf("%.1f %ld %ld\n", weighted(1000, 0.5), evens, fact)
@@ -0,0 +1,28 @@
+import "io"
+import "pool"
+
+struct Event {
+    kind: int;
+    time: double;
+    payload: i64;
+}
+
+new events = pool_new<Event>()
+new first = pool_alloc(events)
+new second = pool_alloc(events)
+
+// Freed objects are handed out again, so the churn needs no new slabs
+for 0..100000 -> i {
+    new a = pool_alloc(events)
+    new b = pool_alloc(events)
+    new c = pool_alloc(events)
+    pool_free(events, b)
+    pool_free(events, a)
+    pool_free(events, c)
+}
+
+printf("%ld %ld %ld\n", pool_live(events), pool_slabs(events), pool_high_water(events))
+pool_free(events, first)
+pool_free(events, second)
+printf("%ld\n", pool_live(events))
+pool_destroy(events)
@@ -0,0 +1,17 @@
+import "io"
+import "string"
+
+// Reads "<name> <count> <price>" records from stdin. Numbers are parsed
+// straight out of the read buffer, with no format string
+new input = scanner_new(0)
+new mut total = 0.0
+while has_next(input) {
+    new name = next_token(input)
+    new count = next_i64(input)
+    new price = next_f64(input)
+    view_print(name)
+    printf(" %ld\n", count)
+    total = total + count * price
+}
+scanner_close(input)
+printf("total %.2f\n", total)
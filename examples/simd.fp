@@ -0,0 +1,15 @@
+import "io"
+import "simd"
+
+new mut xs: float[] = [1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0]
+new a: f32x4 = [1.5, 2.5, 3.5, 4.5]
+new b = f32x4_load(xs, 4)
+
+// Lane-wise; the scalar is broadcast to every lane
+new c = a * b + 1.0
+f32x4_store(xs, 0, c)
+
+new ints: i32x4 = [1, 2, 3, 4]
+new rev = shuffle(ints, ints, [3, 2, 1, 0])
+
+printf("%.1f %.1f %d %d %d\n", xs[0], reduce_add(c), rev[0], reduce_max(ints), reduce_mul(ints))
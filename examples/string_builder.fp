@@ -0,0 +1,20 @@
+import "io"
+import "string"
+import "memory"
+
+// Appends are amortized O(1); sb_finish hands the buffer over without
+// copying it, so the result is freed like any other string
+new sb = sb_new(0)
+for 0..5 -> i {
+    sb_append_int(sb, i * i)
+    sb_append_char(sb, 44)
+}
+sb_append(sb, " pi=")
+sb_append_float(sb, 3.25)
+sb_append(sb, " sum=")
+sb_append_float(sb, 0.1 + 0.2)    // every digit needed to read it back
+printf("%ld\n", sb_len(sb))
+
+new text = sb_finish(sb)
+printf("%s\n", text)
+free(text)
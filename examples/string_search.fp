@@ -0,0 +1,18 @@
+import "io"
+import "string"
+
+new line = "2025-01-01 12:00:03 WARN disk=/dev/sda1 used=91% free=8.2G"
+
+printf("%ld %ld %ld\n", str_find(line, "disk="), str_rfind(line, "="), str_count(line, "="))
+printf("%ld %ld %d\n", str_find_any(line, "%!"), str_skip_any(line, "0123456789-"), str_contains_any(line, "#;"))
+
+// Fields are the text between spaces: str_split gives where each one ends
+new length = str_length(line)
+new mut at: i64 = 0
+while at <= length {
+    new stop = str_split(line, " ", at)
+    view_print(slice(line, at, stop))
+    printf("|")
+    at = stop + 1
+}
+printf("\n%d %d\n", str_compare("WARN", "INFO"), str_compare("ab", "abc"))
@@ -0,0 +1,29 @@
+import "io"
+
+// Runs in constant stack: the self call is in tail position
+fn countdown(n: int, steps: int): int
+{
+    if n == 0 {
+        return steps
+    }
+    return countdown(n - 1, steps + 1)
+}
+
+printf("%d\n", countdown(1000000, 0))
+
+// Not a tail call, but the array built on every iteration reuses one
+// stack slot per call instead of growing the frame as the loop runs
+fn walk(depth: int): int
+{
+    if depth == 0 {
+        return 0
+    }
+    new mut sum: int = 0
+    for 0..2000 -> i {
+        new pair: int[] = [i, depth]
+        sum = sum + pair[1] - pair[0]
+    }
+    return sum % 7 + walk(depth - 1)
+}
+
+printf("%d\n", walk(2000))
@@ -0,0 +1,15 @@
+import "io"
+import "types"
+
+new mut total: double = 0.0
+
+for 1..=10 -> i {
+    total = total + itod(i) / 2.0
+}
+
+printf("%.1f %d %d\n", total, dtoi(total), btoi(true))
+
+// float is a double, so dtof keeps single precision by rounding
+new third: float = ftod(1.0 / 3.0)
+printf("%.10f %.10f\n", third, dtof(1.0 / 3.0))
+printf("%.1f %d\n", itof(7) / 2.0, ftoi(-2.75))
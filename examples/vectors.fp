@@ -0,0 +1,22 @@
+import "io"
+import "vec"
+
+fn total(v: int[..], n: int): int
+{
+    new mut sum: int = 0
+    for 0..n -> i {
+        sum = sum + v[i]
+    }
+    return sum
+}
+
+new mut squares: int[..] = [0, 1]
+
+for 2..1000 -> i {
+    vec_push(squares, i * i)
+}
+
+printf("%ld %d %d\n", vec_len(squares), squares[999], total(squares, 10))
+vec_clear(squares)
+printf("%ld %ld\n", vec_len(squares), vec_cap(squares))
+vec_free(squares)
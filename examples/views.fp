@@ -0,0 +1,35 @@
+import "io"
+import "string"
+
+// Views borrow the bytes they point at: slicing never allocates or copies
+fn first_word(s: string[:]): string[:]
+{
+    return slice(s, 0, view_find(s, " "))
+}
+
+new line = "GET /index.html 200"
+new path = slice(line, 4, 15)
+new status = slice(line, 16, 19)
+
+view_print(first_word(slice(line, 0, 19)))
+print(" ")
+view_print(path)
+print("\n")
+
+// No space: view_find gives -1 and the view comes out empty
+print("[")
+view_print(first_word(path))
+print("]\n")
+
+if view_ends_with(path, ".html") {
+    print("html\n")
+}
+
+printf("%ld %ld %s\n", view_to_int(status) + 1, view_find(line, "200"), path[1])
+
+new nums: int[] = [1, 2, 3, 4, 5]
+new mid = slice(nums, 1, 4)
+printf("%ld %d\n", slice_len(mid), mid[2])
+
+// Out of range numbers clamp instead of wrapping
+printf("%ld %ld\n", view_to_int(" 99999999999999999999"), view_to_int("-x"))
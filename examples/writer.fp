@@ -0,0 +1,19 @@
+import "io"
+
+// Writes are buffered and go out in large chunks: when the buffer fills
+// up, on flush() and at exit
+new out = writer_new(1, 0)
+for 1..4 -> i {
+    write_str(out, "line ")
+    write_int(out, i)
+    write_char(out, 32)
+    write_f64(out, i / 8.0)
+    write_char(out, 10)
+}
+flush(out)
+printf("after flush\n")
+
+new err = writer_new(2, 16)
+write_str(err, "to stderr\n")
+writer_close(err)
+write_str(out, "written at exit\n")
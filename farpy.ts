@@ -97,6 +97,18 @@ export class FarpyCompilerMain {
     return this.args.debug === true;
   }
 
+  private isProfiling(): boolean {
+    return this.args.profiling === true;
+  }
+
+  private shouldCheckBounds(): boolean {
+    return this.args["bounds-check"] === true;
+  }
+
+  private shouldEmitDebugInfo(): boolean {
+    return this.args.g === true || this.isProfiling();
+  }
+
   private isCliMode(): boolean {
     return this.args.cli === true;
   }
@@ -182,8 +194,8 @@ export class FarpyCompilerMain {
     return analyzer;
   }
 
-  private runOptimizer(ast: Program): Program | null {
-    const optimizer = new Optimizer(this.reporter).resume(ast);
+  private runOptimizer(ast: Program, semantic: Semantic): Program | null {
+    const optimizer = new Optimizer(this.reporter, semantic).resume(ast);
 
     if (!this.checkErrorsAndWarnings()) return null;
 
@@ -194,16 +206,36 @@ export class FarpyCompilerMain {
     semanticAST: Program,
     semantic: Semantic,
     debug: boolean,
-  ): { ir: string; externs: string[] } {
-    const llvmIrGen = LLVMIRGenerator.getInstance(this.reporter, debug);
+  ): { ir: string; externs: string[]; hasLoopHints: boolean } {
+    const llvmIrGen = LLVMIRGenerator.getInstance(
+      this.reporter,
+      debug,
+      this.shouldEmitDebugInfo(),
+      this.shouldCheckBounds(),
+    );
     const ir = llvmIrGen.generateIR(semanticAST, semantic, this.fileName);
     llvmIrGen.resetInstance(); // Reset
+    if (this.shouldCheckBounds()) {
+      this.reportBoundsChecks(llvmIrGen.boundsCheckStats);
+    }
     return {
       ir: ir,
       externs: llvmIrGen.externs,
+      hasLoopHints: llvmIrGen.hasLoopHints,
     };
   }
 
+  private reportBoundsChecks(
+    stats: LLVMIRGenerator["boundsCheckStats"],
+  ): void {
+    const eliminated = stats.covered + stats.proven;
+    Logger.info(
+      `Bounds checks: ${stats.sites} index sites, ${stats.checked} checked per access, ` +
+        `${eliminated} eliminated (${stats.covered} by ${stats.hoisted} loop-entry checks, ` +
+        `${stats.proven} proven in range)`,
+    );
+  }
+
   private handleEmitIR(): boolean {
     return this.args["emit-ir"] != "";
   }
@@ -213,6 +245,7 @@ export class FarpyCompilerMain {
     semantic: Semantic,
     target: string = "",
     externs: string[],
+    hasLoopHints: boolean = false,
   ): Promise<void> {
     const compiler = new FarpyCompiler(
       llvmIR,
@@ -221,6 +254,10 @@ export class FarpyCompilerMain {
       this.args["debug"],
       target,
       externs,
+      hasLoopHints,
+      this.shouldEmitDebugInfo(),
+      this.isProfiling(),
+      this.args.veclib ?? "",
     );
     await compiler.compile();
   }
@@ -243,7 +280,7 @@ export class FarpyCompilerMain {
       semantic.resetInstance(); // Reset
 
       if (this.shouldOptimize()) {
-        ast = this.runOptimizer(ast);
+        ast = this.runOptimizer(ast, semantic);
       }
 
       if (this.shouldDeadCode()) {
@@ -256,6 +293,8 @@ export class FarpyCompilerMain {
         this.isDebug(),
       );
 
+      if (!this.checkErrorsAndWarnings()) return;
+
       if (this.handleEmitIR()) {
         await Deno.writeFile(
           `${this.fileName.replace(".fp", ".ll")}`,
@@ -269,6 +308,7 @@ export class FarpyCompilerMain {
         semantic,
         this.args.target ?? "",
         llvmIR.externs,
+        llvmIR.hasLoopHints,
       );
     } catch (error: unknown) {
       console.error("Compilation failed:", error);
@@ -148,11 +148,17 @@ export class FarpyCompiler {
     private debug: boolean = false,
     private target: string = "",
     private externs: string[] = [],
+    private hasLoopHints: boolean = false,
+    private debugInfo: boolean = false,
+    private profiling: boolean = false,
+    private vectorLibm: string = "",
   ) {
     // Calculate total steps for progress tracking
     this.totalSteps = 4; // Base compilation steps
     if (this.externs.length > 0) this.totalSteps += 1;
-    if (this.instance.stdLibs.size > 0) this.totalSteps += 1;
+    if (this.stdLibSources(this.instance.stdLibs).size > 0) {
+      this.totalSteps += 1;
+    }
   }
 
   private log(message: string): void {
@@ -199,7 +205,7 @@ export class FarpyCompiler {
     args: string[],
     errorMessage: string,
     progressMessage: string = "",
-  ): Promise<void> {
+  ): Promise<string> {
     if (this.debug) {
       this.log(`Running: ${colors.dim}${cmd} ${args.join(" ")}${colors.reset}`);
 
@@ -220,6 +226,7 @@ export class FarpyCompiler {
           }
 
           spinner.stop();
+          return new TextDecoder().decode(stderr);
         } catch (error) {
           spinner.stop();
           throw error;
@@ -235,6 +242,8 @@ export class FarpyCompiler {
           );
           Deno.exit(-1);
         }
+
+        return new TextDecoder().decode(stderr);
       }
     } else {
       const command = new Deno.Command(cmd, { args });
@@ -247,6 +256,8 @@ export class FarpyCompiler {
         );
         Deno.exit(-1);
       }
+
+      return new TextDecoder().decode(stderr);
     }
   }
 
@@ -302,10 +313,18 @@ export class FarpyCompiler {
     if (this.debug) Logger.info("External dependencies processed successfully");
   }
 
-  private async compileStdLibs(
+  // Modules defined entirely in IR are already part of the user's module
+  private stdLibSources(
     stdLibs: Map<string, StdLibModule>,
+  ): Map<string, StdLibModule> {
+    return new Map([...stdLibs].filter(([_, module]) => !module.irOnly));
+  }
+
+  private async compileStdLibs(
+    importedLibs: Map<string, StdLibModule>,
     destFile: string,
   ): Promise<string[]> {
+    const stdLibs = this.stdLibSources(importedLibs);
     if (stdLibs.size === 0) return [];
 
     this.logStep("Compiling standard libraries");
@@ -342,7 +361,11 @@ export class FarpyCompiler {
         throw new Error(`Source file for library "${lib}" not found.`);
       }
 
-      let args = [libPath, "-c", "-emit-llvm", "-o", libFile];
+      // Without -O the bitcode is marked optnone and stays unoptimized
+      // after linking, which costs the SIMD kernels most of their speed.
+      let args = [libPath, "-c", "-emit-llvm", "-O2", "-o", libFile];
+
+      if (this.debugInfo) args.push(...this.debugInfoFlags());
 
       if (module.flags) {
         args = [...args, ...module.flags];
@@ -378,6 +401,22 @@ export class FarpyCompiler {
     return modulesArgs;
   }
 
+  private debugInfoFlags(): string[] {
+    const flags = ["-g"];
+    if (this.profiling) {
+      flags.push("-fno-omit-frame-pointer", "-mno-omit-leaf-frame-pointer");
+    }
+    return flags;
+  }
+
+  private reportLoopRemarks(diagnostics: string): void {
+    for (const line of diagnostics.split("\n")) {
+      if (line.includes("remark:") || line.includes("loop not")) {
+        Logger.warning(line.trim());
+      }
+    }
+  }
+
   private cleanupTempFiles(): void {
     if (this.debug) {
       const spinner = Logger.spinner("Cleaning up temporary files");
@@ -451,39 +490,56 @@ export class FarpyCompiler {
         "-fdata-sections",
         "-ffunction-sections",
         "-Wl,--gc-sections",
-        "-Wl,-s",
-        "-fomit-frame-pointer",
         "-fstrict-aliasing",
         "-ffast-math",
         "-fno-rtti",
         "-funwind-tables",
-        "-g0",
+        ...(this.debugInfo
+          ? this.debugInfoFlags()
+          : ["-Wl,-s", "-fomit-frame-pointer", "-g0"]),
         ...moduleArgs,
       ];
       if (this.target) args.push("-target", this.target);
 
-      await this.executeCommand(
+      // Loop hints are only read by the loop passes, which need an
+      // optimization level; ask clang to report the ones it drops.
+      if (this.hasLoopHints) {
+        args.push("-O2", "-Rpass-missed=loop-(unroll|vectorize)");
+      }
+
+      // Math intrinsics in vectorized loops become calls to the SIMD
+      // variants of the given vector math library.
+      if (this.vectorLibm) {
+        args.push("-O2", `-fveclib=${this.vectorLibm}`);
+        if (this.vectorLibm == "libmvec") args.push("-lmvec");
+      }
+
+      const diagnostics = await this.executeCommand(
         "clang",
         args,
         "Error compiling binary:",
         "Transforming bitcode into executable magic",
       );
+      if (this.hasLoopHints) this.reportLoopRemarks(diagnostics);
       if (this.debug) Logger.success("Binary compilation completed");
 
       this.logStep("Optimizing binary");
-      await this.executeCommand(
-        "strip",
-        ["--strip-all", this.outputFile],
-        "Error optimizing binary:",
-        "Stripping unnecessary symbols",
-      );
+      // Symbols and line tables are what -g/--profiling builds are for
+      if (!this.debugInfo) {
+        await this.executeCommand(
+          "strip",
+          ["--strip-all", this.outputFile],
+          "Error optimizing binary:",
+          "Stripping unnecessary symbols",
+        );
 
-      await this.executeCommand(
-        "upx",
-        [this.outputFile, "--best"],
-        "Error optimizing binary with upx:",
-        "Applying UPX compression for maximum efficiency",
-      );
+        await this.executeCommand(
+          "upx",
+          [this.outputFile, "--best"],
+          "Error optimizing binary with upx:",
+          "Applying UPX compression for maximum efficiency",
+        );
+      }
 
       const compilationTime = performance.now() - this.compilationStartTime;
 
@@ -80,6 +80,9 @@ export enum TokenType {
   FROM, // from 61
   HEXADECIMAL, // 0x111 62
   OCTAL, // 0o777 63
+  AT, // @unroll 64
+  PFOR, // pfor 65
+  REGION, // region 66
 }
 
 export type NativeValue =
@@ -115,6 +118,8 @@ export const Keywords: Record<string, TokenType> = {
   "fn": TokenType.FN,
   "return": TokenType.RETURN,
   "for": TokenType.FOR,
+  "pfor": TokenType.PFOR,
+  "region": TokenType.REGION,
   "while": TokenType.WHILE,
   "import": TokenType.IMPORT,
   "as": TokenType.AS,
@@ -36,6 +36,8 @@ export interface TypeInfo {
   isPointer: boolean;
   isStruct: boolean;
   pointerLevel: number;
+  isVector?: boolean; // Growable `T[..]`
+  isSlice?: boolean; // Borrowed `T[:]` view (pointer + length)
 }
 
 export function createTypeInfo(
@@ -67,6 +69,20 @@ export function createArrayType(
   };
 }
 
+export function createVectorType(baseType: TypesNative | string): TypeInfo {
+  return {
+    ...createTypeInfo(baseType),
+    isVector: true,
+  };
+}
+
+export function createSliceType(baseType: TypesNative | string): TypeInfo {
+  return {
+    ...createTypeInfo(baseType),
+    isSlice: true,
+  };
+}
+
 export function createPointerType(
   baseType: TypeInfo,
   pointerLevel: number = 1,
@@ -97,6 +113,14 @@ export function typeInfoToString(type: TypeInfo): string {
     }
   }
 
+  if (type.isVector) {
+    result += "[..]";
+  }
+
+  if (type.isSlice) {
+    result += "[:]";
+  }
+
   if (type.isPointer) {
     result = "*".repeat(type.pointerLevel) + result;
   }
@@ -134,6 +158,7 @@ export type NodeType =
   | "StructPAssignment"
   | "ExternStatement"
   | "WhileStatement"
+  | "RegionStatement"
   | "UnaryExpr"
   | "AddressOfExpr"
   | "DereferenceExpr"
@@ -329,6 +354,8 @@ export interface CallExpr extends Expr {
   callee: Identifier;
   type: TypeInfo;
   arguments: Expr[] | Stmt[];
+  tailCall?: boolean; // Direct self-call in tail position
+  typeArgument?: TypeInfo; // `T` in alloc<T>(n)
 }
 
 export interface ImportStatement extends Stmt {
@@ -351,6 +378,7 @@ export interface FunctionDeclaration extends Stmt {
   id: Identifier;
   block: Stmt[];
   scope?: Map<string, SymbolInfo>;
+  tailRecursive?: boolean;
 }
 
 export interface ReturnStatement extends Stmt {
@@ -378,6 +406,13 @@ export interface ElseStatement extends Stmt {
   primary: Stmt[];
 }
 
+// `@unroll(4)`, `@nounroll`, `@vectorize(8)`, `@interleave(2)`
+export interface LoopHint {
+  name: "unroll" | "nounroll" | "vectorize" | "interleave";
+  count: number | null;
+  loc: Loc;
+}
+
 export interface ForRangeStatement extends Stmt {
   kind: "ForRangeStatement";
   id: Identifier | null;
@@ -385,7 +420,17 @@ export interface ForRangeStatement extends Stmt {
   to: Expr;
   inclusive: boolean; // `..=` = true, `..` = false
   step?: Expr;
+  hints: LoopHint[];
   block: Stmt[];
+  parallel?: boolean; // `pfor`: iterations run on the thread pool
+  reductions?: Reduction[];
+  scope?: Map<string, SymbolInfo>; // `pfor`: the counter and body locals
+}
+
+// `reduce + sum`: each chunk accumulates into its own copy of `sum`
+export interface Reduction {
+  operator: "+" | "*";
+  id: Identifier;
 }
 
 // TODO
@@ -447,6 +492,13 @@ export interface ExternStatement extends Stmt {
 export interface WhileStatement extends Stmt {
   kind: "WhileStatement";
   condition: Expr;
+  hints: LoopHint[];
+  block: Stmt[];
+}
+
+// Allocations made by the stdlib inside the block are released when it ends
+export interface RegionStatement extends Stmt {
+  kind: "RegionStatement";
   block: Stmt[];
 }
 
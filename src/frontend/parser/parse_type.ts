@@ -11,7 +11,9 @@ import { TypesNative } from "../values.ts";
 import {
   createArrayType,
   createPointerType,
+  createSliceType,
   createTypeInfo,
+  createVectorType,
   TypeInfo,
 } from "./ast.ts";
 
@@ -22,6 +24,9 @@ import {
  * - Arrays (int[], string[], etc)
  * - Arrays multidimensionais (int[][], int[][][], etc)
  * - Ponteiros (*int, **int, etc)
+ * - Vetores dinâmicos (int[..], double[..], etc)
+ * - Views (string[:], int[:], etc)
+ * - Atômicos (atomic<int>, atomic<i64>, atomic<ptr>)
  * - Combinações (*int[], int*[], **int[][], etc)
  */
 export class ParseType {
@@ -37,6 +42,17 @@ export class ParseType {
 
     const baseType = this.parseBaseType();
 
+    if (this.parseVectorSuffix()) {
+      const vectorType = createVectorType(baseType);
+      return pointerLevel > 0
+        ? createPointerType(vectorType, pointerLevel)
+        : vectorType;
+    }
+
+    if (this.parseSliceSuffix()) {
+      return createSliceType(baseType);
+    }
+
     const dimensions = this.parseArrayDimensions();
 
     let typeInfo: TypeInfo;
@@ -73,13 +89,59 @@ export class ParseType {
 
   private parseBaseType(): TypesNative | string {
     const token = this.advance();
+
+    if (token.value === "atomic" && this.match(TokenType.LESS_THAN)) {
+      return this.parseAtomicType();
+    }
+
     return this.tokenValueToTypesNative(token);
   }
 
+  // `atomic<T>`: any pointer type is stored as `atomic<ptr>`
+  private parseAtomicType(): string {
+    const pointer = this.parsePointerPrefix() > 0;
+    const base = this.tokenValueToTypesNative(this.advance());
+    const element = pointer ? "ptr" : base;
+    this.match(TokenType.GREATER_THAN);
+    return `atomic<${element}>`;
+  }
+
+  // `[..]` marks a growable vector
+  private parseVectorSuffix(): boolean {
+    if (
+      this.check(TokenType.LBRACKET) &&
+      this.tokens[this.current + 1]?.kind === TokenType.RANGE &&
+      this.tokens[this.current + 2]?.kind === TokenType.RBRACKET
+    ) {
+      this.current += 3;
+      return true;
+    }
+
+    return false;
+  }
+
+  // `[:]` marks a view
+  private parseSliceSuffix(): boolean {
+    if (
+      this.check(TokenType.LBRACKET) &&
+      this.tokens[this.current + 1]?.kind === TokenType.COLON &&
+      this.tokens[this.current + 2]?.kind === TokenType.RBRACKET
+    ) {
+      this.current += 3;
+      return true;
+    }
+
+    return false;
+  }
+
   private parseArrayDimensions(): number {
     let dimensions = 0;
 
-    while (this.match(TokenType.LBRACKET, TokenType.RBRACKET)) {
+    while (
+      this.check(TokenType.LBRACKET) &&
+      this.tokens[this.current + 1]?.kind === TokenType.RBRACKET
+    ) {
+      this.current += 2;
       dimensions++;
     }
 
@@ -38,9 +38,12 @@ import {
   IfStatement,
   ImportStatement,
   IndexAccess,
+  LoopHint,
   NullLiteral,
   PointerAssignment as _PointerAssignment,
   Program,
+  Reduction,
+  RegionStatement,
   ReturnStatement,
   Stmt,
   StructExpr,
@@ -57,6 +60,9 @@ import { ParseType } from "./parse_type.ts";
 
 type InfixParseFn = (left: Expr) => Expr;
 
+// Builtins called with a type argument, `alloc<T>(n)`
+const TYPED_CALLS = new Set(["alloc", "alloc_zeroed", "pool_new"]);
+
 enum Precedence {
   LOWEST = 1,
   ASSIGN = 2, // =
@@ -162,14 +168,23 @@ export class Parser {
         return this.parseIfStatement();
       case TokenType.FOR:
         return this.parseForStatement();
+      case TokenType.PFOR:
+        return this.parseForStatement(true);
       case TokenType.EXTERN:
         return this.parseExternStatement();
       case TokenType.WHILE:
         return this.parseWhileStatement();
+      case TokenType.REGION:
+        return this.parseRegionStatement();
       case TokenType.LBRACKET:
         return this.parseArrayLiteral();
       case TokenType.IDENTIFIER: {
         const name = token.value!.toString();
+        if (
+          TYPED_CALLS.has(name) && this.peek().kind === TokenType.LESS_THAN
+        ) {
+          return this.parseTypedCall(AST_IDENTIFIER(name, token.loc));
+        }
         if (this.peek().kind === TokenType.LPAREN) {
           return this.parseCallExpression(AST_IDENTIFIER(name, token.loc));
         }
@@ -250,11 +265,27 @@ export class Parser {
     }
   }
 
-  private parseArrowExpression(): ArrowExpression | StructPAssignment {
+  private parseArrowExpression():
+    | ArrowExpression
+    | StructPAssignment
+    | CallExpr {
     const name = this.previous();
     this.consume(TokenType.DOT, "Expected '.' for struct access propertie.");
     const propertie = this.parseExpression(Precedence.LOWEST);
 
+    // `x.f(args)` is sugar for `f(x, args)`, e.g. `s.cstr()`
+    if (propertie.kind == "CallExpr") {
+      const call = propertie as CallExpr;
+      return {
+        ...call,
+        arguments: [
+          AST_IDENTIFIER(String(name.value), name.loc),
+          ...call.arguments,
+        ],
+        loc: this.makeLoc(name.loc, call.loc),
+      } as CallExpr;
+    }
+
     if (propertie.kind == "Identifier") {
       return {
         kind: "ArrowExpression",
@@ -558,6 +589,7 @@ export class Parser {
     const start = this.previous();
     const body: Expr[] = [];
     const condition = this.parseExpression(Precedence.LOWEST);
+    const hints = this.parseLoopHints();
 
     this.consume(
       TokenType.LBRACE,
@@ -576,6 +608,7 @@ export class Parser {
     return {
       kind: "WhileStatement",
       condition: condition,
+      hints: hints,
       block: body,
       type: createTypeInfo("void"),
       value: "void",
@@ -583,6 +616,33 @@ export class Parser {
     };
   }
 
+  private parseRegionStatement(): RegionStatement {
+    const start = this.previous();
+    const body: Expr[] = [];
+
+    this.consume(
+      TokenType.LBRACE,
+      "A '{' was expected to start the region block.",
+    );
+
+    while (!this.check(TokenType.RBRACE) && !this.isAtEnd()) {
+      body.push(this.parseExpression(Precedence.LOWEST));
+    }
+
+    const end = this.consume(
+      TokenType.RBRACE,
+      "A '}' was expected to close the region block.",
+    );
+
+    return {
+      kind: "RegionStatement",
+      block: body,
+      type: createTypeInfo("void"),
+      value: "void",
+      loc: this.makeLoc(start.loc, end.loc),
+    };
+  }
+
   private parseExternStatement(): ExternStatement {
     const start = this.previous();
     const language = this.consume(
@@ -665,7 +725,9 @@ export class Parser {
 
   // private parseArrowExpression();
 
-  private parseForStatement(): ForRangeStatement | ForCStyleStatement {
+  private parseForStatement(
+    parallel: boolean = false,
+  ): ForRangeStatement | ForCStyleStatement {
     const start = this.previous();
     const from = this.advance();
 
@@ -715,6 +777,9 @@ export class Parser {
       );
     }
 
+    const reductions = parallel ? this.parseReductions() : [];
+    const hints = this.parseLoopHints();
+
     this.consume(
       TokenType.LBRACE,
       "A '{' was expected to start the for block.",
@@ -743,13 +808,148 @@ export class Parser {
         ? AST_INT(Number(to.value), to.loc)
         : AST_IDENTIFIER(String(to.value), to.loc),
       inclusive: inclusive,
+      hints: hints,
       block: body,
+      parallel: parallel,
+      reductions: reductions,
       type: createTypeInfo("null"),
       value: AST_NULL({} as Loc),
       loc: this.makeLoc(start.loc, end.loc),
     } as ForRangeStatement;
   }
 
+  // pfor 0..n -> i reduce + sum reduce * product { ... }
+  private parseReductions(): Reduction[] {
+    const reductions: Reduction[] = [];
+
+    while (
+      this.check(TokenType.IDENTIFIER) && this.peek().value == "reduce"
+    ) {
+      this.advance(); // reduce
+      const operator = this.advance();
+
+      if (
+        operator.kind != TokenType.PLUS && operator.kind != TokenType.ASTERISK
+      ) {
+        this.reporter.addError(
+          operator.loc,
+          "A reduction operator ('+' or '*') was expected after 'reduce'.",
+        );
+        throw new Error(
+          "A reduction operator ('+' or '*') was expected after 'reduce'.",
+        );
+      }
+
+      const id = this.consume(
+        TokenType.IDENTIFIER,
+        "A variable was expected after the reduction operator.",
+      );
+      reductions.push({
+        operator: operator.kind == TokenType.PLUS ? "+" : "*",
+        id: AST_IDENTIFIER(String(id.value), id.loc),
+      });
+    }
+
+    return reductions;
+  }
+
+  // Loop hints written between the loop header and its block:
+  // for 0..n -> i @unroll(4) @vectorize(8) { ... }
+  private parseLoopHints(): LoopHint[] {
+    const hints: LoopHint[] = [];
+
+    while (this.match(TokenType.AT)) {
+      const name = this.consume(
+        TokenType.IDENTIFIER,
+        "A loop hint name was expected after '@'.",
+      );
+      const hintName = String(name.value);
+
+      if (
+        !["unroll", "nounroll", "vectorize", "interleave"].includes(hintName)
+      ) {
+        this.reporter.addError(
+          name.loc,
+          `Unknown loop hint '@${hintName}'.`,
+          [
+            this.reporter.makeSuggestion(
+              "Valid hints are @unroll, @nounroll, @vectorize and @interleave.",
+            ),
+          ],
+        );
+        throw new Error(`Unknown loop hint '@${hintName}'.`);
+      }
+
+      let count: number | null = null;
+
+      if (this.match(TokenType.LPAREN)) {
+        const value = this.consume(
+          TokenType.INT,
+          "An integer was expected for the loop hint.",
+        );
+        this.consume(
+          TokenType.RPAREN,
+          "A ')' was expected to close the loop hint.",
+        );
+        count = Number(value.value);
+
+        if (hintName == "nounroll") {
+          this.reporter.addError(
+            value.loc,
+            "'@nounroll' does not take a count.",
+          );
+          throw new Error("'@nounroll' does not take a count.");
+        }
+
+        if (count < 1) {
+          this.reporter.addError(
+            value.loc,
+            `The count of '@${hintName}' must be at least 1.`,
+          );
+          throw new Error(`The count of '@${hintName}' must be at least 1.`);
+        }
+
+        if (hintName == "vectorize" && (count & (count - 1)) != 0) {
+          this.reporter.addError(
+            value.loc,
+            "The width of '@vectorize' must be a power of two.",
+          );
+          throw new Error("The width of '@vectorize' must be a power of two.");
+        }
+      } else if (hintName == "interleave") {
+        this.reporter.addError(
+          name.loc,
+          "'@interleave' requires a count, e.g. '@interleave(2)'.",
+        );
+        throw new Error("'@interleave' requires a count.");
+      }
+
+      const conflicting = hints.find((hint) =>
+        hint.name == hintName ||
+        (hint.name == "unroll" && hintName == "nounroll") ||
+        (hint.name == "nounroll" && hintName == "unroll")
+      );
+
+      if (conflicting) {
+        this.reporter.addError(
+          name.loc,
+          `'@${hintName}' conflicts with '@${conflicting.name}' on the same loop.`,
+        );
+        throw new Error(
+          `'@${hintName}' conflicts with '@${conflicting.name}' on the same loop.`,
+        );
+      }
+
+      hints.push({
+        name: hintName as LoopHint["name"],
+        count: count,
+        loc: name.loc,
+      });
+    }
+
+    return hints;
+  }
+
   private parseIfStatement(miaKhalifa: boolean = true): IfStatement {
     const start = this.previous();
     const condition = this.parseExpression(Precedence.LOWEST);
@@ -1029,6 +1229,36 @@ export class Parser {
     } as CallExpr;
   }
 
+  // alloc<T>(n): the type between '<' and '>' is parsed like any other
+  private parseTypedCall(callee: Identifier): Expr {
+    this.advance(); // <
+    const tokens: Token[] = [];
+    let depth = 0;
+
+    while (!this.isAtEnd()) {
+      if (this.check(TokenType.GREATER_THAN) && depth == 0) break;
+      if (this.check(TokenType.LESS_THAN)) depth++;
+      if (this.check(TokenType.GREATER_THAN)) depth--;
+      tokens.push(this.advance());
+    }
+
+    this.consume(
+      TokenType.GREATER_THAN,
+      `Expect '>' after the type of '${callee.value}'.`,
+    );
+
+    if (!this.check(TokenType.LPAREN)) {
+      this.consume(
+        TokenType.LPAREN,
+        `Expect '(' after '${callee.value}<...>'.`,
+      );
+    }
+
+    const call = this.parseCallExpression(callee) as CallExpr;
+    call.typeArgument = new ParseType(tokens).parse();
+    return call;
+  }
+
   private getInfixFn(kind: TokenType): InfixParseFn | undefined {
     switch (kind) {
       case TokenType.PLUS:
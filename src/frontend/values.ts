@@ -48,3 +48,22 @@ export enum PrefixOperator {
   NEGATE = "-", // Negação numérica
   NOT = "!", // Negação lógica
 }
+
+// SIMD vector types, lowered to LLVM `<lanes x element>` values
+export const SimdTypes: Record<string, { lanes: number; element: string }> = {
+  f32x4: { lanes: 4, element: "float" },
+  f32x8: { lanes: 8, element: "float" },
+  f64x2: { lanes: 2, element: "double" },
+  f64x4: { lanes: 4, element: "double" },
+  i32x4: { lanes: 4, element: "i32" },
+  i32x8: { lanes: 8, element: "i32" },
+  i64x2: { lanes: 2, element: "i64" },
+  i64x4: { lanes: 4, element: "i64" },
+};
+
+// `atomic<T>` slots: the value type they hold in memory
+export const AtomicTypes: Record<string, { element: string; llvm: string }> = {
+  "atomic<int>": { element: "int", llvm: "i32" },
+  "atomic<i64>": { element: "i64", llvm: "i64" },
+  "atomic<ptr>": { element: "ptr", llvm: "ptr" },
+};
@@ -37,7 +37,9 @@ export class FunctionBuilder {
   returns(type: TypeInfo): FunctionBuilder {
     this.function.returnType = type;
     // Set default LLVM type based on return type
-    this.function.llvmType = this.typeChecker.mapToLLVMType(type.baseType);
+    this.function.llvmType = type.isSlice
+      ? this.typeChecker.mapToLLVMSliceType(type.baseType)
+      : this.typeChecker.mapToLLVMType(type.baseType);
     return this;
   }
 
@@ -15,6 +15,7 @@ import {
   BinaryLiteral,
   CallExpr,
   CastExpr,
+  createTypeInfo,
   ElifStatement,
   Expr,
   ExternStatement,
@@ -26,8 +27,11 @@ import {
   IndexAccess,
   IntLiteral,
   LLVMType,
+  LoopHint,
   NullLiteral,
   Program,
+  Reduction,
+  RegionStatement,
   ReturnStatement,
   Stmt,
   StringLiteral,
@@ -39,43 +43,98 @@ import {
   VariableDeclaration,
   WhileStatement,
 } from "../frontend/parser/ast.ts";
+import { AtomicTypes, SimdTypes } from "../frontend/values.ts";
 import {
   createStringGlobal,
   IRValue,
   LLVMBasicBlock,
+  LLVMDebugInfo,
   LLVMFunction,
   LLVMModule,
+  stringByteLength,
 } from "../ts-ir/index.ts";
+import { VERSION } from "../../config.ts";
 import { Semantic } from "./semantic.ts";
+import {
+  ALLOC_FUNCTIONS,
+  ATOMIC_FUNCTIONS,
+  ATOMIC_ORDERINGS,
+  FAT_STRING_FUNCTIONS,
+  SIMD_FUNCTIONS,
+  SLICE_FUNCTIONS,
+  VECTOR_FUNCTIONS,
+} from "./standard_library.ts";
 import { StdLibFunction } from "./std_lib_module_builder.ts";
 import { TypeChecker } from "./type_checker.ts";
 
+// `str` values; the layout matches farpy_str in stdlib/string.c
+const FAT_STRING = "%farpy.str";
+
 export class LLVMIRGenerator {
   private static instance: LLVMIRGenerator | null;
   private module: LLVMModule = new LLVMModule();
   private variables: Map<string, IRValue> = new Map();
   private stringConstants: Map<string, IRValue> = new Map();
   private declaredFuncs: Set<string> = new Set();
+  private vectorTypes: Map<string, string> = new Map(); // %farpy.vec.T -> T
+  private sliceTypes: Map<string, string> = new Map(); // %farpy.slice.T -> T
+  private charTable: string | null = null;
   private currentLoopIncBlock: LLVMBasicBlock | null = null;
   private currentLoopBlock: LLVMBasicBlock | null = null;
   public externs: string[] = []; // Bad
+  public hasLoopHints: boolean = false;
+  private parallelLoops: number = 0; // Numbers the outlined pfor bodies
+  private regionMarks: IRValue[] = []; // Open `region` blocks, outermost first
+  public boundsCheckStats = {
+    sites: 0, // Index expressions that can be checked
+    checked: 0, // Checked on every access
+    hoisted: 0, // Loop-level checks emitted in place of per-access ones
+    covered: 0, // Accesses covered by a loop-level check
+    proven: 0, // Accesses proven in range at compile time
+  };
+  // Accesses whose check was hoisted to loop entry or proven unnecessary
+  private boundsCovered: Map<IndexAccess, "covered" | "proven"> = new Map();
   private readonly reporter: DiagnosticReporter;
   private readonly debug: boolean;
+  private readonly emitDebugInfo: boolean;
+  private readonly boundsCheck: boolean;
+  private debugInfo: LLVMDebugInfo | null = null;
   protected instance: Semantic;
   private lastStructPtr: IRValue = this.makeIrValue("0", "i32");
-
-  private constructor(reporter: DiagnosticReporter, debug: boolean) {
+  private currentFunction: {
+    name: string;
+    retType: string;
+    params: IRValue[]; // Parameter slots, in declaration order
+    paramTypes: string[];
+    header: LLVMBasicBlock | null; // Target of self tail calls
+  } | null = null;
+
+  private constructor(
+    reporter: DiagnosticReporter,
+    debug: boolean,
+    emitDebugInfo: boolean,
+    boundsCheck: boolean,
+  ) {
     this.reporter = reporter;
     this.debug = debug;
+    this.emitDebugInfo = emitDebugInfo;
+    this.boundsCheck = boundsCheck;
     this.instance = Semantic.getInstance(this.reporter);
   }
 
   public static getInstance(
     reporter: DiagnosticReporter,
     debug: boolean,
+    emitDebugInfo: boolean = false,
+    boundsCheck: boolean = false,
   ): LLVMIRGenerator {
     if (!LLVMIRGenerator.instance) {
-      LLVMIRGenerator.instance = new LLVMIRGenerator(reporter, debug);
+      LLVMIRGenerator.instance = new LLVMIRGenerator(
+        reporter,
+        debug,
+        emitDebugInfo,
+        boundsCheck,
+      );
     }
     return LLVMIRGenerator.instance;
   }
@@ -96,6 +155,19 @@ export class LLVMIRGenerator {
     const target = this.getTargetTriple();
     if (target) this.module.addExternal(`target triple = "${target}"\n`);
 
+    if (this.instance.importedModules.has("string")) {
+      this.module.addGlobal(`${FAT_STRING} = type { i8*, i64, [16 x i8] }`);
+    }
+
+    if (this.emitDebugInfo) {
+      this.debugInfo = new LLVMDebugInfo(
+        this.module,
+        file,
+        Deno.cwd(),
+        `Farpy Compiler ${VERSION}`,
+      );
+    }
+
     this.generateProgram(program);
     return this.module.toString();
   }
@@ -109,8 +181,13 @@ export class LLVMIRGenerator {
     const mainFunc = new LLVMFunction("main", "i32", []);
     const entry = mainFunc.createBasicBlock("entry");
     mainFunc.setCurrentBasicBlock(entry);
+    this.attachDebugScope(mainFunc, 1);
 
     for (const node of program.body!) {
+      if (node.kind == "VariableDeclaration") {
+        this.generateGlobalDeclaration(node as VariableDeclaration, mainFunc);
+        continue;
+      }
       this.generateNode(node, mainFunc);
     }
 
@@ -125,6 +202,38 @@ export class LLVMIRGenerator {
   ): IRValue {
     const entry = _entry == null ? main.getCurrentBasicBlock() : _entry;
 
+    const previousLocation = main.debugLocation;
+    if (this.debugInfo && main.debugScope && node.loc?.line) {
+      main.debugLocation = this.debugInfo.getLocation(
+        node.loc.line,
+        node.loc.start + 1,
+        main.debugScope,
+      );
+    }
+
+    try {
+      return this.generateNodeKind(node, entry, main);
+    } finally {
+      main.debugLocation = previousLocation;
+    }
+  }
+
+  // Every function gets a DISubprogram and a default location, so calls
+  // emitted outside any statement still carry the `!dbg` LLVM requires.
+  // Frame pointers are kept so profilers can unwind Farpy frames.
+  private attachDebugScope(func: LLVMFunction, line: number): void {
+    if (!this.debugInfo) return;
+
+    func.attributes.push(`"frame-pointer"="all"`);
+    func.debugScope = this.debugInfo.createSubprogram(func.name, line);
+    func.debugLocation = this.debugInfo.getLocation(line, 1, func.debugScope);
+  }
+
+  private generateNodeKind(
+    node: Stmt | Expr,
+    entry: LLVMBasicBlock,
+    main: LLVMFunction,
+  ): IRValue {
     switch (node.kind) {
       case "BinaryExpr":
         return this.generateBinaryExpr(node as BinaryExpr, entry, main);
@@ -169,6 +278,12 @@ export class LLVMIRGenerator {
           entry,
           main,
         );
+      case "RegionStatement":
+        return this.generateRegionStatement(
+          node as RegionStatement,
+          entry,
+          main,
+        );
       case "ExternStatement":
         return this.generateExternStatement(
           node as ExternStatement,
@@ -241,9 +356,39 @@ export class LLVMIRGenerator {
     entry: LLVMBasicBlock,
     main: LLVMFunction,
   ): IRValue {
-    const element = this.generateNode(node.target, main);
+    const element = this.generateAddressable(node.target, main);
     const index = this.generateNode(node.index, main);
 
+    if (this.boundsCheck) {
+      this.checkIndexBounds(node, element, index, main);
+    }
+    // The index (or its check) may have left us in a later block
+    entry = main.getCurrentBasicBlock();
+
+    // Vector: straight GEP on the data pointer
+    if (this.isVectorValue(element)) {
+      const elementType = this.vectorTypes.get(element.type.slice(0, -1))!;
+      const data = entry.getStructField(element, 0, `${elementType}*`);
+      return entry.loadInst(entry.getPointerElementPtr(data, index));
+    }
+
+    // View: same, through the data pointer held in the value
+    if (this.sliceTypes.has(element.type)) {
+      const elementType = this.sliceTypes.get(element.type)!;
+      const data = entry.extractValueInst(element, 0, `${elementType}*`);
+      return elementType == "i8"
+        ? entry.getStringElementPtr(data, index, this.getCharTable())
+        : entry.loadInst(entry.getPointerElementPtr(data, index));
+    }
+
+    // SIMD value: a single lane
+    if (this.isSimdValue(element)) {
+      return this.simdLaneValue(
+        entry.extractElementInst(element, index),
+        entry,
+      );
+    }
+
     // Array
     if (element.type.includes("x")) {
       return entry.getArrayElement(
@@ -261,6 +406,7 @@ export class LLVMIRGenerator {
           ? element
           : entry.toPtr(element),
         index,
+        this.getCharTable(),
       );
     }
 
@@ -270,6 +416,136 @@ export class LLVMIRGenerator {
     );
   }
 
+  // `--bounds-check`: a single unsigned compare rejects both negative
+  // indices and indices past the end. Strings carry no length and are left
+  // unchecked.
+  private checkIndexBounds(
+    node: IndexAccess,
+    element: IRValue,
+    index: IRValue,
+    main: LLVMFunction,
+  ): void {
+    const block = main.getCurrentBasicBlock();
+    const length = this.boundsLength(element, block);
+    if (!length) return;
+
+    this.boundsCheckStats.sites++;
+
+    const hoisted = this.boundsCovered.get(node);
+    if (hoisted) {
+      this.boundsCheckStats[hoisted]++;
+      return;
+    }
+
+    if (node.index.kind == "IntLiteral" && !isNaN(Number(length.value))) {
+      const position = Number(node.index.value);
+      if (position >= 0 && position < Number(length.value)) {
+        this.boundsCheckStats.proven++;
+        return;
+      }
+
+      const message =
+        `Index ${position} is out of bounds for '${node.target.value}' of length ${length.value}`;
+      this.reporter.addError(node.index.loc, message);
+      throw new Error(message);
+    }
+
+    this.boundsCheckStats.checked++;
+    const position = block.convertValueToType(index, "i64");
+    this.emitBoundsCheck(
+      block.icmpInst("ult", position, length),
+      position,
+      length,
+      node.loc.line,
+      main,
+    );
+  }
+
+  // Element count as an i64: a constant for arrays, the `len` field for
+  // vectors and views. Null when the value has no known length.
+  private boundsLength(
+    element: IRValue,
+    block: LLVMBasicBlock,
+  ): IRValue | null {
+    const array = element.type.match(/^\[(\d+) x /);
+    if (array) {
+      return { value: array[1], type: "i64" };
+    }
+
+    if (this.isVectorValue(element)) {
+      return block.getStructField(element, 1, "i64");
+    }
+
+    if (this.sliceTypes.has(element.type)) {
+      return block.extractValueInst(element, 1, "i64");
+    }
+
+    const simd = element.type.match(/^<(\d+) x \w+>$/);
+    if (simd) {
+      return { value: simd[1], type: "i64" };
+    }
+
+    return null;
+  }
+
+  // Branches to a cold, non-returning failure block unless `inBounds`
+  // holds; code generation continues in the fall-through block.
+  private emitBoundsCheck(
+    inBounds: IRValue,
+    index: IRValue,
+    length: IRValue,
+    line: number,
+    main: LLVMFunction,
+  ): void {
+    const block = main.getCurrentBasicBlock();
+    const failBlock = main.createBasicBlock("bounds.fail" + main.nextBlockId());
+    const okBlock = main.createBasicBlock("bounds.ok" + main.nextBlockId());
+
+    block.condBrInst(inBounds, okBlock.label, failBlock.label);
+
+    failBlock.callInst(
+      "void",
+      this.getBoundsFailHandler(),
+      [index, length, { value: String(line), type: "i32" }],
+      ["i64", "i64", "i32"],
+    );
+    failBlock.add("unreachable");
+
+    main.setCurrentBasicBlock(okBlock);
+  }
+
+  private getBoundsFailHandler(): string {
+    const name = "farpy.bounds_fail";
+    if (this.declaredFuncs.has(name)) return name;
+
+    const message = "index %ld out of bounds for length %ld (line %d)\n";
+    const size = message.length + 1;
+
+    this.declareRuntimeFunction(
+      "dprintf",
+      "declare i32 @dprintf(i32, i8*, ...)",
+    );
+    this.declareRuntimeFunction("exit", "declare void @exit(i32)");
+    this.module.addGlobal(
+      `@farpy.bounds_msg = private unnamed_addr constant [${size} x i8] c"${
+        message.replace("\n", "\\0A")
+      }\\00", align 1`,
+    );
+    this.declareRuntimeFunction(
+      name,
+      [
+        `define internal void @${name}(i64 %index, i64 %length, i32 %line) cold noinline noreturn nounwind {`,
+        "entry:",
+        `  %format = getelementptr inbounds [${size} x i8], [${size} x i8]* @farpy.bounds_msg, i64 0, i64 0`,
+        "  %written = call i32 (i32, i8*, ...) @dprintf(i32 2, i8* %format, i64 %index, i64 %length, i32 %line)",
+        "  call void @exit(i32 1)",
+        "  unreachable",
+        "}",
+      ].join("\n"),
+    );
+    return name;
+  }
+
   private generateArrowExpression(
     node: ArrowExpression,
     entry: LLVMBasicBlock,
@@ -288,6 +564,7 @@ export class LLVMIRGenerator {
     main: LLVMFunction,
   ): IRValue {
     const value = this.generateNode(node.to.value, main);
+    entry = main.getCurrentBasicBlock();
     entry.setStructField(
       this.lastStructPtr,
       node.index!,
@@ -299,10 +576,10 @@ export class LLVMIRGenerator {
 
   private generateStructExpr(
     node: StructExpr,
-    entry: LLVMBasicBlock,
-    _main: LLVMFunction,
+    _entry: LLVMBasicBlock,
+    main: LLVMFunction,
   ): IRValue {
-    this.lastStructPtr = entry.allocaStructInst(node.llvmType!);
+    this.lastStructPtr = main.allocaInEntry(node.llvmType!);
     return this.lastStructPtr;
   }
 
@@ -327,21 +604,53 @@ export class LLVMIRGenerator {
     main: LLVMFunction,
   ): IRValue {
     const value = this.generateNode(node.expr, main);
+    entry = main.getCurrentBasicBlock();
     return entry.convertValueToType(value, node.llvmType!);
   }
 
+  // All-literal arrays are emitted once as read-only data. Callers that
+  // never write to the array (`copy == false`) use the global directly;
+  // everyone else gets a stack copy made with a single memcpy.
   private generateArrayLiteral(
     node: ArrayLiteral,
     entry: LLVMBasicBlock,
     main: LLVMFunction,
+    copy: boolean = true,
   ): IRValue {
+    const initializer = this.constantArrayInitializer(node);
+
+    if (initializer != null) {
+      const arrayType = `[${node.value.length} x ${node.llvmType}]`;
+      const label = `@.arr${this.module.globals.length}`;
+
+      this.module.addGlobal(
+        `${label} = private unnamed_addr constant ${arrayType} ${initializer}, align ${
+          entry.getAlign(arrayType)
+        }`,
+      );
+
+      const global: IRValue = { value: label, type: `${arrayType}*` };
+      if (!copy) return global;
+
+      if (!this.declaredFuncs.has("llvm.memcpy")) {
+        this.declaredFuncs.add("llvm.memcpy");
+        this.module.addExternal(
+          "declare void @llvm.memcpy.p0i8.p0i8.i64(i8*, i8*, i64, i1)",
+        );
+      }
+
+      const ptr = main.allocaInEntry(arrayType);
+      entry.memcpyInst(ptr, global);
+      return ptr;
+    }
+
     const values: string[] = [];
 
     for (const value of node.value) {
       values.push(value.value);
     }
 
-    const ptr = entry.allocaArrayInst(node.llvmType!, node.value.length);
+    const ptr = main.allocaInEntry(`[${node.value.length} x ${node.llvmType}]`);
 
     for (let i = 0; i < values.length; i++) {
       entry.setArrayElement(
@@ -360,6 +669,7 @@ export class LLVMIRGenerator {
     main: LLVMFunction,
   ): IRValue {
     const operand = this.generateNode(node.operand, main);
+    entry = main.getCurrentBasicBlock();
 
     if (this.debug) {
       entry.add(
@@ -378,6 +688,13 @@ export class LLVMIRGenerator {
           console.log(`Cannot dereference non-pointer type ${operand.type}`);
           return this.makeIrValue("0", "i32"); // Default error value
         }
+        // An opaque pointer loads the pointee type semantic worked out
+        if (operand.type == "ptr" && node.llvmType != LLVMType.PTR) {
+          return entry.loadInst({
+            value: operand.value,
+            type: `${node.llvmType}*`,
+          });
+        }
         return entry.loadInst({ value: operand.value, type: operand.type });
       }
 
@@ -504,14 +821,27 @@ export class LLVMIRGenerator {
     entry: LLVMBasicBlock,
     main: LLVMFunction,
   ): IRValue {
-    const value = this.generateNode(node.value, main);
+    let value = this.generateNode(node.value, main);
+    entry = main.getCurrentBasicBlock();
     const ptr = this.variables.get(node.id.value);
+    if (ptr!.type == `${FAT_STRING}*`) {
+      value = this.toFatString(node.value, value, entry);
+    }
+    const target = ptr!.type.slice(0, -1);
+    if (this.isNumericType(value.type) && this.isNumericType(target)) {
+      value = entry.convertValueToType(value, target);
+    }
     entry.storeInst(value, ptr!);
     return ptr!;
   }
 
   // Versão corrigida dos métodos de geração de loops
 
+  // Loops are emitted in rotated form: a guard in the preheader, the
+  // induction variable as a phi at the top of the body and a single
+  // compare on the latch. With a literal step the direction is known at
+  // compile time, so LLVM sees a canonical `add nsw` IV with a computable
+  // trip count.
   private generateForRangeStmt(
     node: ForRangeStatement,
     entry: LLVMBasicBlock,
@@ -523,7 +853,10 @@ export class LLVMIRGenerator {
       );
     }
 
-    const condBlock = main.createBasicBlock("for.cond" + main.nextBlockId());
+    if (node.parallel) {
+      return this.generateParallelForStmt(node, main);
+    }
+
     const bodyBlock = main.createBasicBlock("for.body" + main.nextBlockId());
     const incBlock = main.createBasicBlock("for.inc" + main.nextBlockId());
     const endBlock = main.createBasicBlock("for.end" + main.nextBlockId());
@@ -535,72 +868,67 @@ export class LLVMIRGenerator {
     const previousLoopIncBlock = this.currentLoopIncBlock;
     const previousLoopBlock = this.currentLoopBlock;
 
-    const fromExpr = this.generateNode(node.from, main);
-    const toExpr = this.generateNode(node.to, main);
-
-    let counterVar: IRValue;
-    let counterName: string;
-
-    if (node.id) {
-      counterName = node.id.value;
-      counterVar = entry.allocaInst("i32");
-      this.variables.set(counterName, counterVar);
-    } else {
-      counterName = "_for_idx" + main.nextBlockId();
-      counterVar = entry.allocaInst("i32");
-      this.variables.set(counterName, counterVar);
-    }
-
-    entry.storeInst(fromExpr, counterVar);
-
-    let stepExpr: IRValue;
-    if (node.step) {
-      stepExpr = this.generateNode(node.step, main);
+    const from = this.generateNode(node.from, main);
+    const to = this.generateNode(node.to, main);
+    const step = node.step
+      ? this.generateNode(node.step, main)
+      : this.makeIrValue("1", "i32");
+
+    // Guard: skip the loop entirely when the range is empty
+    const preheader = main.getCurrentBasicBlock();
+    const fromExpr = preheader.convertValueToType(from, "i32");
+    const toExpr = preheader.convertValueToType(to, "i32");
+    const stepExpr = preheader.convertValueToType(step, "i32");
+
+    const counterName = node.id
+      ? node.id.value
+      : "_for_idx" + main.nextBlockId();
+    const counterVar = main.allocaInEntry("i32");
+    this.variables.set(counterName, counterVar);
+
+    const compare = this.makeForRangeCompare(
+      node,
+      stepExpr,
+      toExpr,
+      preheader,
+    );
+    // Hoisted bounds checks run once, on the path that enters the body
+    let loopEntry = preheader;
+    const hoisted = this.hoistLoopBoundsChecks(node);
+    if (hoisted.size > 0) {
+      const checkBlock = main.createBasicBlock(
+        "for.check" + main.nextBlockId(),
+      );
+      preheader.condBrInst(
+        compare(preheader, fromExpr, toExpr),
+        checkBlock.label,
+        endBlock.label,
+      );
+      main.setCurrentBasicBlock(checkBlock);
+      this.emitLoopBoundsChecks(node, hoisted, fromExpr, toExpr, main);
+      loopEntry = main.getCurrentBasicBlock();
+      loopEntry.brInst(bodyBlock.label);
     } else {
-      stepExpr = this.makeIrValue("1", "i32");
+      preheader.condBrInst(
+        compare(preheader, fromExpr, toExpr),
+        bodyBlock.label,
+        endBlock.label,
+      );
     }
 
-    // Branch to condition block from current block
-    entry.brInst(condBlock.label);
-    main.setCurrentBasicBlock(condBlock);
-
-    const counterVal = condBlock.loadInst(counterVar);
-
-    const positiveComp = node.inclusive ? "sle" : "slt";
-    const negativeComp = node.inclusive ? "sge" : "sgt";
-
-    // Check step direction
-    const isPositiveStep = condBlock.nextTemp();
-    condBlock.add(
-      `${isPositiveStep} = icmp sgt ${stepExpr.type} ${stepExpr.value}, 0`,
-    );
-
-    const condPositive = condBlock.nextTemp();
-    const condNegative = condBlock.nextTemp();
-    const condition = condBlock.nextTemp();
-
-    condBlock.add(
-      `${condPositive} = icmp ${positiveComp} ${counterVal.type} ${counterVal.value}, ${toExpr.value}`,
-    );
-    condBlock.add(
-      `${condNegative} = icmp ${negativeComp} ${counterVal.type} ${counterVal.value}, ${toExpr.value}`,
-    );
-    condBlock.add(
-      `${condition} = select i1 ${isPositiveStep}, i1 ${condPositive}, i1 ${condNegative}`,
-    );
-
-    condBlock.condBrInst(
-      { value: condition, type: "i1" },
-      bodyBlock.label,
-      endBlock.label,
-    );
-
     // Generate loop body
     main.setCurrentBasicBlock(bodyBlock);
 
+    const ivNext = bodyBlock.nextTemp();
+    const iv = bodyBlock.phiInst("i32", [
+      [fromExpr.value, loopEntry.label],
+      [ivNext, incBlock.label],
+    ]);
+    bodyBlock.storeInst(iv, counterVar);
+
     // Set the current loop context for nested loops
     this.currentLoopIncBlock = incBlock;
-    this.currentLoopBlock = condBlock;
+    this.currentLoopBlock = bodyBlock;
 
     for (const stmt of node.block) {
       this.generateNode(stmt, main);
@@ -620,12 +948,15 @@ export class LLVMIRGenerator {
       currentBodyBlock.brInst(incBlock.label);
     }
 
-    // Generate increment block
+    // Generate the latch: increment and the single exit test
     main.setCurrentBasicBlock(incBlock);
-    const counterCurr = incBlock.loadInst(counterVar);
-    const counterNext = incBlock.addInst(counterCurr, stepExpr);
-    incBlock.storeInst(counterNext, counterVar);
-    incBlock.brInst(condBlock.label);
+    incBlock.add(`${ivNext} = add nsw i32 ${iv.value}, ${stepExpr.value}`);
+    incBlock.condBrInst(
+      compare(incBlock, { value: ivNext, type: "i32" }, toExpr),
+      bodyBlock.label,
+      endBlock.label,
+    );
+    this.generateLoopHints(node.hints, node.block, bodyBlock, main);
 
     // Set current block to end block for continuation
     main.setCurrentBasicBlock(endBlock);
@@ -636,168 +967,743 @@ export class LLVMIRGenerator {
     return this.makeIrValue("0", "i32");
   }
 
-  private generateWhileStatement(
-    node: WhileStatement,
-    entry: LLVMBasicBlock,
+  // `pfor` hands its body to farpy_pfor() (parallel.c) as
+  // `farpy.pfor.N(ctx, chunk, lo, hi)`, which runs iterations [lo, hi).
+  // Locals the body reads travel by address in `ctx`. Each reduction is
+  // accumulated privately and left in slot `chunk` of a partials array
+  // that the caller folds in chunk order, so the result is the same on
+  // any number of threads.
+  private generateParallelForStmt(
+    node: ForRangeStatement,
     main: LLVMFunction,
   ): IRValue {
-    if (this.debug) {
-      entry.add(
-        `; DEBUG - LINE: ${node.loc.line} | RAW: ${node.loc.line_string}`,
+    const step = node.step ? Number(node.step.value) : 1;
+    if (step == 0) {
+      this.reporter.addError(
+        node.step!.loc,
+        "The step of a for loop cannot be zero.",
       );
+      throw new Error("The step of a for loop cannot be zero.");
     }
 
-    const condBlock = main.createBasicBlock("while.cond" + main.nextBlockId());
-    const bodyBlock = main.createBasicBlock("while.body" + main.nextBlockId());
-    const endBlock = main.createBasicBlock("while.end" + main.nextBlockId());
+    const from = Number(node.from.value);
+    const to = this.generateNode(node.to, main);
+    const block = main.getCurrentBasicBlock();
+    const count = this.parallelTripCount(
+      from,
+      block.convertValueToType(to, "i64"),
+      step,
+      node.inclusive,
+      block,
+    );
 
-    // Store the previous loop context
+    const counterName = node.id ? node.id.value : "";
+    const reductions = (node.reductions ?? []).map((reduction) => ({
+      ...reduction,
+      variable: this.variables.get(reduction.id.value)!,
+    }));
+    const reduced = new Set(reductions.map((r) => r.id.value));
+
+    // Locals mentioned in the body; globals are reachable from any thread
+    const captures: string[] = [];
+    this.forEachNode(node.block, (child) => {
+      if (child.kind != "Identifier") return;
+      const name = child.value as string;
+      const variable = this.variables.get(name);
+      if (
+        variable && !variable.value.startsWith("@") && name != counterName &&
+        !reduced.has(name) && !captures.includes(name)
+      ) {
+        captures.push(name);
+      }
+    });
+
+    const chunks = 64;
+    const slots: IRValue[] = captures.map((name) => this.variables.get(name)!);
+    const partials = reductions.map((reduction) => {
+      const type = reduction.variable.type.slice(0, -1);
+      const array = main.allocaInEntry(`[${chunks} x ${type}]`);
+      return block.convertValueToType(array, `${type}*`);
+    });
+
+    let ctx: IRValue = { value: "null", type: "i8*" };
+    const fields = [...slots, ...partials];
+    if (fields.length > 0) {
+      const array = main.allocaInEntry(`[${fields.length} x i8*]`);
+      const base = block.convertValueToType(array, "i8**");
+      fields.forEach((field, index) => {
+        block.storeInst(
+          block.convertValueToType(field, "i8*"),
+          block.getPointerElementPtr(base, {
+            value: String(index),
+            type: "i64",
+          }),
+        );
+      });
+      ctx = block.convertValueToType(array, "i8*");
+    }
+
+    const body = this.generateParallelBody(
+      node,
+      captures,
+      slots,
+      reductions.map((r, i) => ({
+        ...r,
+        partials: partials[i],
+      })),
+      counterName,
+    );
+
+    const bodyType = "void (i8*, i64, i64, i64)*";
+    this.declareRuntimeFunction(
+      "farpy_pfor",
+      `declare void @farpy_pfor(${bodyType}, i8*, i64, i64)`,
+    );
+    block.callInst(
+      "void",
+      "farpy_pfor",
+      [
+        { value: `@${body.name}`, type: bodyType },
+        ctx,
+        count,
+        { value: String(chunks), type: "i64" },
+      ],
+      [bodyType, "i8*", "i64", "i64"],
+    );
+
+    if (reductions.length > 0) {
+      this.mergeReductions(reductions, partials, count, chunks, main);
+    }
+
+    return this.makeIrValue("0", "i32");
+  }
+
+  // Iterations of `from..to step s`: ceil(distance / |s|), or 0 when the
+  // range is empty. `..=` adds one to the distance so `to` is included.
+  private parallelTripCount(
+    from: number,
+    to: IRValue,
+    step: number,
+    inclusive: boolean,
+    block: LLVMBasicBlock,
+  ): IRValue {
+    const i64 = (value: number): IRValue => ({
+      value: String(value),
+      type: "i64",
+    });
+    const magnitude = Math.abs(step);
+
+    let distance = step > 0
+      ? block.subInst(to, i64(from))
+      : block.subInst(i64(from), to);
+    if (inclusive) distance = block.addInst(distance, i64(1));
+
+    const trips = block.divInst(
+      block.addInst(distance, i64(magnitude - 1)),
+      i64(magnitude),
+    );
+    return block.selectInst(
+      block.icmpInst("sgt", distance, i64(0)),
+      trips,
+      i64(0),
+    );
+  }
+
+  private generateParallelBody(
+    node: ForRangeStatement,
+    captures: string[],
+    slots: IRValue[],
+    reductions: (Reduction & { variable: IRValue; partials: IRValue })[],
+    counterName: string,
+  ): LLVMFunction {
+    const func = new LLVMFunction(
+      `farpy.pfor.${this.parallelLoops++}`,
+      "void",
+      [
+        { name: "ctx", type: "i8*" },
+        { name: "chunk", type: "i64" },
+        { name: "lo", type: "i64" },
+        { name: "hi", type: "i64" },
+      ],
+    );
+    const entry = func.createBasicBlock("entry");
+    func.setCurrentBasicBlock(entry);
+    this.attachDebugScope(func, node.loc.line);
+
+    const outerVariables = this.variables;
+    const previousFunction = this.currentFunction;
     const previousLoopIncBlock = this.currentLoopIncBlock;
     const previousLoopBlock = this.currentLoopBlock;
 
-    // Branch to condition block
-    entry.brInst(condBlock.label);
-    main.setCurrentBasicBlock(condBlock);
+    this.variables = new Map(
+      [...outerVariables].filter(([, value]) => value.value.startsWith("@")),
+    );
+    this.currentFunction = null;
 
-    // Evaluate the while condition
-    const cond = this.generateNode(node.condition, main);
-    condBlock.condBrInst(cond, bodyBlock.label, endBlock.label);
+    const base = entry.convertValueToType(
+      { value: "%ctx", type: "i8*" },
+      "i8**",
+    );
+    const field = (index: number, type: string): IRValue =>
+      entry.convertValueToType(
+        entry.loadInst(
+          entry.getPointerElementPtr(base, {
+            value: String(index),
+            type: "i64",
+          }),
+        ),
+        type,
+      );
 
-    // Generate the loop body
-    main.setCurrentBasicBlock(bodyBlock);
+    captures.forEach((name, index) => {
+      this.variables.set(name, field(index, slots[index].type));
+    });
 
-    // Set the current loop context for nested loops
-    this.currentLoopIncBlock = condBlock; // For while loops, we continue to the condition
-    this.currentLoopBlock = condBlock;
+    const accumulators = reductions.map((reduction, index) => {
+      const type = reduction.variable.type.slice(0, -1);
+      const partials = field(captures.length + index, reduction.partials.type);
+      const accumulator = func.allocaInEntry(type);
+      entry.storeInst(
+        {
+          value: this.reductionIdentity(reduction.operator, type),
+          type,
+        },
+        accumulator,
+      );
+      this.variables.set(reduction.id.value, accumulator);
+      return { accumulator, partials };
+    });
 
+    const counterVar = func.allocaInEntry("i32");
+    if (counterName) this.variables.set(counterName, counterVar);
+
+    // Chunks are never empty, so the loop is entered unconditionally
+    const bodyBlock = func.createBasicBlock("pfor.body" + func.nextBlockId());
+    const incBlock = func.createBasicBlock("pfor.inc" + func.nextBlockId());
+    const exitBlock = func.createBasicBlock("pfor.exit" + func.nextBlockId());
+    entry.brInst(bodyBlock.label);
+
+    func.setCurrentBasicBlock(bodyBlock);
+    const next = bodyBlock.nextTemp();
+    const k = bodyBlock.phiInst("i64", [
+      ["%lo", entry.label],
+      [next, incBlock.label],
+    ]);
+    const offset = bodyBlock.mulInst(k, {
+      value: String(node.step ? Number(node.step.value) : 1),
+      type: "i64",
+    });
+    const iv = bodyBlock.addInst(offset, {
+      value: String(Number(node.from.value)),
+      type: "i64",
+    });
+    bodyBlock.storeInst(bodyBlock.convertValueToType(iv, "i32"), counterVar);
+
+    this.currentLoopIncBlock = incBlock;
+    this.currentLoopBlock = bodyBlock;
+
+    this.instance.scopeStack.push(node.scope!);
     for (const stmt of node.block) {
-      this.generateNode(stmt, main);
+      this.generateNode(stmt, func);
+    }
+    this.instance.scopeStack.pop();
+
+    const last = func.getCurrentBasicBlock();
+    if (!this.isTerminated(last)) last.brInst(incBlock.label);
+
+    func.setCurrentBasicBlock(incBlock);
+    incBlock.add(`${next} = add nsw i64 ${k.value}, 1`);
+    incBlock.condBrInst(
+      incBlock.icmpInst("slt", { value: next, type: "i64" }, {
+        value: "%hi",
+        type: "i64",
+      }),
+      bodyBlock.label,
+      exitBlock.label,
+    );
+    this.generateLoopHints(node.hints, node.block, bodyBlock, func);
+
+    func.setCurrentBasicBlock(exitBlock);
+    for (const { accumulator, partials } of accumulators) {
+      exitBlock.storeInst(
+        exitBlock.loadInst(accumulator),
+        exitBlock.getPointerElementPtr(partials, {
+          value: "%chunk",
+          type: "i64",
+        }),
+      );
     }
+    exitBlock.retVoid();
 
-    // Restore the previous loop context
+    this.variables = outerVariables;
+    this.currentFunction = previousFunction;
     this.currentLoopIncBlock = previousLoopIncBlock;
     this.currentLoopBlock = previousLoopBlock;
 
-    // Only add branch back to condition if the body doesn't terminate with a return or branch
-    const currentBodyBlock = main.getCurrentBasicBlock();
-    if (
-      !currentBodyBlock.instructions.some((instr) =>
-        instr.trim().startsWith("ret ") || instr.trim().startsWith("br ")
-      )
-    ) {
-      currentBodyBlock.brInst(condBlock.label);
-    }
-
-    // Set current block to end block for continuation
-    main.setCurrentBasicBlock(endBlock);
+    this.module.addFunction(func);
+    return func;
+  }
 
-    return this.makeIrValue("0", "i32");
+  private reductionIdentity(operator: "+" | "*", type: string): string {
+    const one = operator == "*";
+    if (type == "double" || type == "float") return one ? "1.0" : "0.0";
+    return one ? "1" : "0";
   }
 
-  // Também é necessário atualizar o método generateIfStmt para funcionar corretamente dentro de loops
-  private generateIfStmt(
-    node: IfStatement | ElifStatement,
-    entry: LLVMBasicBlock,
+  // var = ((var op p[0]) op p[1]) ... over the chunks farpy_pfor() ran,
+  // i.e. min(count, chunks) of them.
+  private mergeReductions(
+    reductions: (Reduction & { variable: IRValue })[],
+    partials: IRValue[],
+    count: IRValue,
+    chunks: number,
     main: LLVMFunction,
-    sharedContinueLabel?: LLVMBasicBlock,
-  ): IRValue {
-    if (this.debug) {
-      entry.add(
-        `; DEBUG - LINE: ${node.loc.line} | RAW: ${node.loc.line_string}`,
-      );
-    }
-
-    const cond = this.generateNode(node.condition as Expr, main);
-
-    const ifLabel = main.createBasicBlock(
-      "if_label" + main.nextBlockId(),
+  ): void {
+    const preheader = main.getCurrentBasicBlock();
+    const limit: IRValue = { value: String(chunks), type: "i64" };
+    const used = preheader.selectInst(
+      preheader.icmpInst("slt", count, limit),
+      count,
+      limit,
     );
-    const elseLabel = main.createBasicBlock(
-      "else_label" + main.nextBlockId(),
+    const initial = reductions.map((r) => preheader.loadInst(r.variable));
+
+    const mergeBlock = main.createBasicBlock("pfor.merge" + main.nextBlockId());
+    const doneBlock = main.createBasicBlock("pfor.done" + main.nextBlockId());
+    preheader.condBrInst(
+      preheader.icmpInst("sgt", used, { value: "0", type: "i64" }),
+      mergeBlock.label,
+      doneBlock.label,
     );
 
-    // Create continue label only if we're not in a loop and no shared label is provided
-    const continueLabel = sharedContinueLabel ||
-      (this.currentLoopIncBlock
-        ? null // Don't create a continue label if we're in a loop
-        : main.createBasicBlock("continue_label" + main.nextBlockId()));
-
-    main.getCurrentBasicBlock().condBrInst(
-      cond,
-      ifLabel.label,
-      elseLabel.label,
+    main.setCurrentBasicBlock(mergeBlock);
+    const next = mergeBlock.nextTemp();
+    const k = mergeBlock.phiInst("i64", [
+      ["0", preheader.label],
+      [next, mergeBlock.label],
+    ]);
+    const merged = reductions.map((reduction, index) => {
+      const type = initial[index].type;
+      const accNext = mergeBlock.nextTemp();
+      const acc = mergeBlock.phiInst(type, [
+        [initial[index].value, preheader.label],
+        [accNext, mergeBlock.label],
+      ]);
+      const partial = mergeBlock.loadInst(
+        mergeBlock.getPointerElementPtr(partials[index], k),
+      );
+      const opcode = (type == "double" ? "f" : "") +
+        (reduction.operator == "+" ? "add" : "mul");
+      mergeBlock.add(
+        `${accNext} = ${opcode} ${type} ${acc.value}, ${partial.value}`,
+      );
+      return accNext;
+    });
+    mergeBlock.add(`${next} = add nsw i64 ${k.value}, 1`);
+    mergeBlock.condBrInst(
+      mergeBlock.icmpInst("slt", { value: next, type: "i64" }, used),
+      mergeBlock.label,
+      doneBlock.label,
     );
 
-    // Generate if body
-    main.setCurrentBasicBlock(ifLabel);
-    for (const stmt of node.primary) {
-      this.generateNode(stmt, main);
-    }
+    main.setCurrentBasicBlock(doneBlock);
+    reductions.forEach((reduction, index) => {
+      const type = initial[index].type;
+      const value = doneBlock.phiInst(type, [
+        [initial[index].value, preheader.label],
+        [merged[index], mergeBlock.label],
+      ]);
+      doneBlock.storeInst(value, reduction.variable);
+    });
+  }
+
+  // `a[i]` indexed by the variable of a unit-stride loop needs one check
+  // against the first and last value of `i` rather than one per iteration.
+  // Only accesses that run on every iteration qualify (not those under an
+  // `if`, a nested loop or the right side of `&&`/`||`), and none when the
+  // body can return early: otherwise the loop-level check could fail for
+  // an index the program never reaches. Returns, by target, the accesses
+  // that still need the loop-level runtime check.
+  private hoistLoopBoundsChecks(
+    node: ForRangeStatement,
+  ): Map<string, IndexAccess[]> {
+    const runtime: Map<string, IndexAccess[]> = new Map();
+    const step = node.step ? Number(node.step.value) : 1;
 
-    // Handle if block termination
-    const currentIfBlock = main.getCurrentBasicBlock();
     if (
-      !currentIfBlock.instructions.some((instr) =>
-        instr.trim().startsWith("ret ") ||
-        instr.trim().startsWith("br ")
-      )
+      !this.boundsCheck || !node.id ||
+      (node.step && node.step.kind != "IntLiteral") ||
+      Math.abs(step) != 1
     ) {
-      if (this.currentLoopIncBlock && !sharedContinueLabel) {
-        currentIfBlock.brInst(this.currentLoopIncBlock.label);
-      } else if (continueLabel) {
-        currentIfBlock.brInst(continueLabel.label);
-      }
+      return runtime;
     }
 
-    // Generate else body
-    main.setCurrentBasicBlock(elseLabel);
+    const counter = node.id.value;
+    let returns = false;
+    let redeclared = false;
+    this.forEachNode(node.block, (child) => {
+      if (child.kind == "ReturnStatement") returns = true;
+      if (
+        child.kind == "VariableDeclaration" &&
+        (child as VariableDeclaration).id.value == counter
+      ) {
+        redeclared = true;
+      }
+    });
+    if (returns || redeclared) return runtime;
 
-    if (node.secondary !== null) {
-      if (node.secondary.kind === "ElifStatement") {
-        this.generateIfStmt(
-          node.secondary as ElifStatement,
-          elseLabel,
-          main,
-          continueLabel!,
-        );
-      } else {
-        for (const stmt of node.secondary.primary) {
-          this.generateNode(stmt, main);
-        }
+    const accesses: IndexAccess[] = [];
+    for (const stmt of node.block) {
+      this.collectEveryIterationAccesses(stmt, accesses);
+    }
 
-        const currentElseBlock = main.getCurrentBasicBlock();
+    const byTarget: Map<string, IndexAccess[]> = new Map();
+    for (const access of accesses) {
+      if (
+        access.index.kind != "Identifier" || access.index.value != counter
+      ) {
+        continue;
+      }
+      const name = access.target.value;
+      byTarget.set(name, [...(byTarget.get(name) ?? []), access]);
+    }
+
+    for (const [name, targets] of byTarget) {
+      const variable = this.variables.get(name);
+      if (!variable || name == counter) continue;
+
+      // A view keeps its length unless it is reassigned (or its address
+      // escapes); a vector may only be used through `[]` in the body, and a
+      // global one can also be resized by any user function.
+      let mentions = 0;
+      let indexed = 0;
+      let shadowed = false;
+      let reassigned = false;
+      let userCalls = false;
+      this.forEachNode(node.block, (child) => {
+        switch (child.kind) {
+          case "Identifier":
+            if (child.value == name) mentions++;
+            break;
+          case "IndexAccess":
+            if ((child as IndexAccess).target.value == name) indexed++;
+            break;
+          case "VariableDeclaration":
+            if ((child as VariableDeclaration).id.value == name) {
+              shadowed = true;
+            }
+            break;
+          case "AssignmentDeclaration":
+            if ((child as AssignmentDeclaration).id.value == name) {
+              reassigned = true;
+            }
+            break;
+          case "UnaryExpr": {
+            const unary = child as UnaryExpr;
+            if (
+              unary.operator == "&" && unary.operand.kind == "Identifier" &&
+              unary.operand.value == name
+            ) {
+              reassigned = true;
+            }
+            break;
+          }
+          case "CallExpr": {
+            const callee = this.instance.availableFunctions.get(
+              (child as CallExpr).callee.value,
+            );
+            if (!callee || !("isStdLib" in callee) || !callee.isStdLib) {
+              userCalls = true;
+            }
+            break;
+          }
+        }
+      });
+      if (shadowed) continue;
+
+      const array = variable.type.match(/^\[(\d+) x .+\]\*$/);
+      if (array) {
+        // Arrays have a fixed length, so only the range has to be known
+        const range = this.literalLoopRange(node);
+        if (range && range[0] >= 0 && range[1] < Number(array[1])) {
+          for (const access of targets) {
+            this.boundsCovered.set(access, "proven");
+          }
+          continue;
+        }
+      } else if (this.isVectorValue(variable)) {
         if (
-          !currentElseBlock.instructions.some((instr) =>
-            instr.trim().startsWith("ret ") ||
-            instr.trim().startsWith("br ")
-          )
+          mentions != indexed ||
+          (variable.value.startsWith("@") && userCalls)
         ) {
-          if (this.currentLoopIncBlock && !sharedContinueLabel) {
-            currentElseBlock.brInst(this.currentLoopIncBlock.label);
-          } else if (continueLabel) {
-            currentElseBlock.brInst(continueLabel.label);
-          }
+          continue;
         }
+      } else if (this.sliceTypes.has(variable.type.slice(0, -1))) {
+        if (reassigned) continue;
+      } else {
+        continue; // No known length (strings, raw pointers)
       }
-    } else {
-      // Empty else case
-      if (this.currentLoopIncBlock && !sharedContinueLabel) {
-        elseLabel.brInst(this.currentLoopIncBlock.label);
-      } else if (continueLabel) {
-        elseLabel.brInst(continueLabel.label);
+
+      for (const access of targets) {
+        this.boundsCovered.set(access, "covered");
       }
+      runtime.set(name, targets);
     }
 
-    // Only set the current basic block to continue label if it exists and we're not in a loop
-    if (continueLabel && !this.currentLoopIncBlock) {
-      main.setCurrentBasicBlock(continueLabel);
+    return runtime;
+  }
+
+  // First and last value of the loop variable, when both are literals
+  private literalLoopRange(node: ForRangeStatement): [number, number] | null {
+    if (node.from.kind != "IntLiteral" || node.to.kind != "IntLiteral") {
+      return null;
     }
 
-    return this.makeIrValue("0", "i32");
+    const from = Number(node.from.value);
+    const to = Number(node.to.value);
+    const step = node.step ? Number(node.step.value) : 1;
+    const last = node.inclusive ? to : to - step;
+
+    return step > 0 ? [from, last] : [last, from];
   }
 
-  private makeReturnStatement(
-    node: ReturnStatement,
+  // In `check` (only reached when the range is non-empty) the lowest and
+  // highest value of the loop variable are compared against each target's
+  // length once, unsigned, just like a single access.
+  private emitLoopBoundsChecks(
+    node: ForRangeStatement,
+    hoisted: Map<string, IndexAccess[]>,
+    fromExpr: IRValue,
+    toExpr: IRValue,
+    main: LLVMFunction,
+  ): void {
+    const block = main.getCurrentBasicBlock();
+    const step = node.step ? Number(node.step.value) : 1;
+    const from = block.convertValueToType(fromExpr, "i64");
+    const to = block.convertValueToType(toExpr, "i64");
+    const last = node.inclusive
+      ? to
+      : block.subInst(to, { value: String(step), type: "i64" });
+    const [low, high] = step > 0 ? [from, last] : [last, from];
+
+    for (const [_name, accesses] of hoisted) {
+      const element = this.generateAddressable(accesses[0].target, main);
+      const current = main.getCurrentBasicBlock();
+      const length = this.boundsLength(element, current)!;
+
+      const lowInBounds = current.icmpInst("ult", low, length);
+      const highInBounds = current.icmpInst("ult", high, length);
+      this.emitBoundsCheck(
+        current.andInst(lowInBounds, highInBounds),
+        current.selectInst(lowInBounds, high, low),
+        length,
+        node.loc.line,
+        main,
+      );
+      this.boundsCheckStats.hoisted++;
+    }
+  }
+
+  // Index expressions evaluated on every iteration of the enclosing loop
+  private collectEveryIterationAccesses(
+    node: Stmt | null | undefined,
+    out: IndexAccess[],
+  ): void {
+    if (!node) return;
+
+    switch (node.kind) {
+      case "IndexAccess":
+        out.push(node as IndexAccess);
+        this.collectEveryIterationAccesses((node as IndexAccess).index, out);
+        break;
+      case "BinaryExpr": {
+        const expr = node as BinaryExpr;
+        this.collectEveryIterationAccesses(expr.left, out);
+        if (expr.operator != "&&" && expr.operator != "||") {
+          this.collectEveryIterationAccesses(expr.right, out);
+        }
+        break;
+      }
+      case "UnaryExpr":
+        this.collectEveryIterationAccesses((node as UnaryExpr).operand, out);
+        break;
+      case "CastExpr":
+        this.collectEveryIterationAccesses((node as CastExpr).expr, out);
+        break;
+      case "CallExpr":
+        for (const arg of (node as CallExpr).arguments) {
+          this.collectEveryIterationAccesses(arg, out);
+        }
+        break;
+      case "VariableDeclaration":
+      case "AssignmentDeclaration":
+      case "IncrementExpr":
+      case "DecrementExpr":
+        this.collectEveryIterationAccesses(node.value, out);
+        break;
+      case "IfStatement":
+      case "WhileStatement":
+        this.collectEveryIterationAccesses(
+          (node as IfStatement | WhileStatement).condition as Expr,
+          out,
+        );
+        break;
+      case "ForRangeStatement": {
+        const loop = node as ForRangeStatement;
+        this.collectEveryIterationAccesses(loop.from, out);
+        this.collectEveryIterationAccesses(loop.to, out);
+        this.collectEveryIterationAccesses(loop.step, out);
+        break;
+      }
+    }
+  }
+
+  // Calls `visit` on every AST node nested anywhere below `node`
+  private forEachNode(node: unknown, visit: (node: Stmt) => void): void {
+    const children = Array.isArray(node)
+      ? node
+      : node && typeof node == "object"
+      ? Object.values(node)
+      : [];
+
+    for (const child of children) {
+      if (!child || typeof child != "object") continue;
+      if ("kind" in child) visit(child as Stmt);
+      if (Array.isArray(child) || "kind" in child) {
+        this.forEachNode(child, visit);
+      }
+    }
+  }
+
+  private makeForRangeCompare(
+    node: ForRangeStatement,
+    stepExpr: IRValue,
+    toExpr: IRValue,
+    preheader: LLVMBasicBlock,
+  ): (block: LLVMBasicBlock, lhs: IRValue, rhs: IRValue) => IRValue {
+    if (node.step == null || node.step.kind == "IntLiteral") {
+      const step = node.step ? Number(node.step.value) : 1;
+
+      if (step == 0) {
+        this.reporter.addError(
+          node.step!.loc,
+          "The step of a for loop cannot be zero.",
+        );
+        throw new Error("The step of a for loop cannot be zero.");
+      }
+
+      const pred = step > 0
+        ? (node.inclusive ? "sle" : "slt")
+        : (node.inclusive ? "sge" : "sgt");
+
+      return (block, lhs, rhs) => block.icmpInst(pred, lhs, rhs);
+    }
+
+    // Runtime step: resolve the direction once, outside the loop. Flipping
+    // every bit reverses signed order, so a descending loop becomes an
+    // ascending compare of `x ^ -1` and the latch keeps a single icmp.
+    const isPositive = preheader.icmpInst(
+      "sgt",
+      stepExpr,
+      this.makeIrValue("0", "i32"),
+    );
+    const mask = preheader.nextTemp();
+    preheader.add(
+      `${mask} = select i1 ${isPositive.value}, i32 0, i32 -1`,
+    );
+    const maskValue: IRValue = { value: mask, type: "i32" };
+    const limit = preheader.xorInst(toExpr, maskValue);
+
+    return (block, lhs, _rhs) =>
+      block.icmpInst(
+        node.inclusive ? "sle" : "slt",
+        block.xorInst(lhs, maskValue),
+        limit,
+      );
+  }
+
+  // alloc<T>(n) is malloc(n * sizeof(T)), alloc_zeroed<T>(n) is
+  // calloc(n, sizeof(T)).
+  private generateAllocCall(node: CallExpr, main: LLVMFunction): IRValue {
+    const count = this.generateNode(node.arguments[0] as Expr, main);
+    const block = main.getCurrentBasicBlock();
+
+    return this.heapAllocate(
+      this.allocElementType(node.typeArgument!),
+      block.convertValueToType(count, "i64"),
+      node.callee.value == "alloc_zeroed",
+      block,
+    );
+  }
+
+  private allocElementType(type: TypeInfo): string {
+    return type.isPointer ? "i8*" : String(
+      new TypeChecker(this.reporter, this.instance).mapToLLVMType(
+        type.baseType,
+      ),
+    );
+  }
+
+  // Slabs are laid out from the struct type generateStructStatement emitted
+  private generatePoolNew(node: CallExpr, main: LLVMFunction): IRValue {
+    const type = this.allocElementType(node.typeArgument!);
+
+    this.declareRuntimeFunction(
+      "pool_create",
+      "declare ptr @pool_create(i64, i64)",
+    );
+    return main.getCurrentBasicBlock().callInst(
+      "ptr",
+      "pool_create",
+      [this.sizeOf(type), this.alignOf(type)],
+      ["i64", "i64"],
+    );
+  }
+
+  // sizeof(T) is the address of element 1 of a T array at null, a constant
+  // expression LLVM folds to the target's size and padding for T. Built by
+  // hand: makeIrValue would try to format it as a numeric literal.
+  private sizeOf(type: string): IRValue {
+    return {
+      value:
+        `ptrtoint (${type}* getelementptr (${type}, ${type}* null, i32 1) to i64)`,
+      type: "i64",
+    };
+  }
+
+  // alignof(T) is the offset of T after an i8 in `{ i8, T }`
+  private alignOf(type: string): IRValue {
+    const pair = `{ i8, ${type} }`;
+    return {
+      value:
+        `ptrtoint (${type}* getelementptr (${pair}, ${pair}* null, i32 0, i32 1) to i64)`,
+      type: "i64",
+    };
+  }
+
+  private heapAllocate(
+    type: string,
+    count: IRValue,
+    zeroed: boolean,
+    block: LLVMBasicBlock,
+  ): IRValue {
+    const size = this.sizeOf(type);
+
+    if (zeroed) {
+      this.declareRuntimeFunction("calloc", "declare ptr @calloc(i64, i64)");
+      return block.callInst("ptr", "calloc", [count, size], ["i64", "i64"]);
+    }
+
+    this.declareRuntimeFunction("malloc", "declare ptr @malloc(i64)");
+    const bytes = count.value == "1" ? size : block.mulInst(count, size);
+    return block.callInst("ptr", "malloc", [bytes], ["i64"]);
+  }
+
+  // `region { ... }` takes a mark in the thread's arena (arena.c) and makes
+  // it current; ending the region rewinds to the mark in O(1). A return
+  // inside the block ends the outermost open region before leaving.
+  private generateRegionStatement(
+    node: RegionStatement,
     entry: LLVMBasicBlock,
     main: LLVMFunction,
   ): IRValue {
@@ -807,355 +1713,1874 @@ export class LLVMIRGenerator {
       );
     }
 
-    const expr = this.generateNode(node.expr, main);
-    main.getCurrentBasicBlock().retInst(expr);
-    return expr;
+    this.declareRuntimeFunction(
+      "farpy_region_begin",
+      "declare ptr @farpy_region_begin()",
+    );
+    this.declareRuntimeFunction(
+      "farpy_region_end",
+      "declare void @farpy_region_end(ptr)",
+    );
+
+    const mark = main.getCurrentBasicBlock().callInst(
+      "ptr",
+      "farpy_region_begin",
+      [],
+      [],
+    );
+
+    this.regionMarks.push(mark);
+    for (const stmt of node.block) {
+      this.generateNode(stmt, main);
+    }
+    this.regionMarks.pop();
+
+    const block = main.getCurrentBasicBlock();
+    if (!this.isTerminated(block)) this.endRegion(mark, block);
+
+    return this.makeIrValue("0", "i32");
   }
 
-  private generateFnDeclaration(
-    node: FunctionDeclaration,
-    _entry: LLVMBasicBlock,
-    _main: LLVMFunction,
+  private endRegion(mark: IRValue, block: LLVMBasicBlock): void {
+    block.callInst("void", "farpy_region_end", [mark], ["ptr"]);
+  }
+
+  private generateWhileStatement(
+    node: WhileStatement,
+    entry: LLVMBasicBlock,
+    main: LLVMFunction,
   ): IRValue {
-    const scopeInstance = this.instance.scopeStack;
-    this.instance.scopeStack = [node.scope!];
+    if (this.debug) {
+      entry.add(
+        `; DEBUG - LINE: ${node.loc.line} | RAW: ${node.loc.line_string}`,
+      );
+    }
 
-    const funcName = node.id.value;
-    const getFunc = this.instance.availableFunctions
-      .get(funcName);
+    const condBlock = main.createBasicBlock("while.cond" + main.nextBlockId());
+    const bodyBlock = main.createBasicBlock("while.body" + main.nextBlockId());
+    const endBlock = main.createBasicBlock("while.end" + main.nextBlockId());
 
-    const outerVariables = new Map(this.variables);
+    // Store the previous loop context
+    const previousLoopIncBlock = this.currentLoopIncBlock;
+    const previousLoopBlock = this.currentLoopBlock;
 
-    const params = node.args.map((arg) => ({
-      name: arg.id.value,
-      type: arg.llvmType!,
-    }));
+    // Branch to condition block
+    entry.brInst(condBlock.label);
+    main.setCurrentBasicBlock(condBlock);
 
-    const func = new LLVMFunction(funcName, node.llvmType!, params);
-    const funcEntry = func.createBasicBlock("entry");
-    func.setCurrentBasicBlock(funcEntry);
+    // Evaluate the while condition
+    const cond = this.generateNode(node.condition, main);
+    main.getCurrentBasicBlock().condBrInst(
+      cond,
+      bodyBlock.label,
+      endBlock.label,
+    );
 
-    for (
-      const arg of getFunc?.params! as {
-        name: string;
-        type: TypeInfo;
-        llvmType: string;
-      }[]
-    ) {
-      const argName = arg.name;
-      const argType = arg.llvmType!;
+    // Generate the loop body
+    main.setCurrentBasicBlock(bodyBlock);
 
-      const alloca = funcEntry.allocaInst(argType);
+    // Set the current loop context for nested loops
+    this.currentLoopIncBlock = condBlock; // For while loops, we continue to the condition
+    this.currentLoopBlock = condBlock;
 
-      funcEntry.storeInst(
-        { value: `%${argName}`, type: argType },
-        alloca,
-      );
+    for (const stmt of node.block) {
+      this.generateNode(stmt, main);
+    }
 
-      this.variables.set(argName, alloca);
+    // Restore the previous loop context
+    this.currentLoopIncBlock = previousLoopIncBlock;
+    this.currentLoopBlock = previousLoopBlock;
+
+    // Only add branch back to condition if the body doesn't terminate with a return or branch
+    const currentBodyBlock = main.getCurrentBasicBlock();
+    if (
+      !currentBodyBlock.instructions.some((instr) =>
+        instr.trim().startsWith("ret ") || instr.trim().startsWith("br ")
+      )
+    ) {
+      currentBodyBlock.brInst(condBlock.label);
     }
 
-    // TODO
-    let _haveReturn = false;
+    this.generateLoopHints(node.hints, node.block, condBlock, main);
 
-    try {
-      for (const stmt of node.block) {
-        this.generateNode(stmt, func);
-        if (stmt.kind == "ReturnStatement") {
-          _haveReturn = true;
-        }
+    // Set current block to end block for continuation
+    main.setCurrentBasicBlock(endBlock);
+
+    return this.makeIrValue("0", "i32");
+  }
+
+  // Attaches `!llvm.loop` metadata to every back-edge into `header`. LLVM
+  // only reads a loop ID when all latches agree, so each branch is tagged.
+  private generateLoopHints(
+    hints: LoopHint[],
+    body: Stmt[],
+    header: LLVMBasicBlock,
+    main: LLVMFunction,
+  ): void {
+    if (!hints || hints.length == 0) return;
+
+    const loopId = this.module.nextMetadataId();
+    const properties: string[] = [];
+    const addProperty = (node: string) => {
+      const id = this.module.nextMetadataId();
+      this.module.addMetadata(id, node);
+      properties.push(id);
+    };
+
+    for (const hint of hints) {
+      switch (hint.name) {
+        case "unroll":
+          addProperty(
+            hint.count == null
+              ? `!{!"llvm.loop.unroll.enable"}`
+              : `!{!"llvm.loop.unroll.count", i32 ${hint.count}}`,
+          );
+          break;
+        case "nounroll":
+          addProperty(`!{!"llvm.loop.unroll.disable"}`);
+          break;
+        case "vectorize":
+          addProperty(`!{!"llvm.loop.vectorize.enable", i1 true}`);
+          if (hint.count != null) {
+            addProperty(`!{!"llvm.loop.vectorize.width", i32 ${hint.count}}`);
+          }
+          break;
+        case "interleave":
+          addProperty(`!{!"llvm.loop.interleave.count", i32 ${hint.count}}`);
+          break;
+      }
+
+      if (
+        (hint.name == "vectorize" || hint.name == "interleave") &&
+        this.hasEarlyExit(body)
+      ) {
+        this.reporter.addWarning(
+          hint.loc,
+          `'@${hint.name}' will likely be ignored: the loop has an early 'return'.`,
+        );
       }
-    } catch (error) {
-      throw error;
     }
 
-    const currentBlock = func.getCurrentBasicBlock();
-    const hasTerminator = currentBlock.instructions.some(
-      (instr) =>
-        instr.trim().startsWith("ret ") || instr.trim().startsWith("br "),
+    this.module.addMetadata(
+      loopId,
+      `distinct !{${[loopId, ...properties].join(", ")}}`,
     );
 
-    if (!hasTerminator) {
-      if (node.llvmType === "void") {
-        currentBlock.retVoid();
-      } else {
-        currentBlock.retInst({
-          value: "0",
-          type: node.llvmType!,
-        });
+    const label = header.label.replace(/\./g, "\\.");
+    const backEdge = new RegExp(`^br .*%${label}(,|$)`);
+    const start = main.basicBlocks.indexOf(header);
+
+    for (const block of main.basicBlocks.slice(start)) {
+      block.instructions = block.instructions.map((instr) =>
+        backEdge.test(instr.trim()) ? `${instr}, !llvm.loop ${loopId}` : instr
+      );
+    }
+
+    this.hasLoopHints = true;
+  }
+
+  private hasEarlyExit(body: Stmt[]): boolean {
+    return body.some((stmt) => {
+      if (!stmt) return false;
+      switch (stmt.kind) {
+        case "ReturnStatement":
+          return true;
+        case "IfStatement":
+        case "ElifStatement":
+        case "ElseStatement": {
+          const node = stmt as IfStatement;
+          return this.hasEarlyExit(node.primary) ||
+            (node.secondary != null && this.hasEarlyExit([node.secondary]));
+        }
+        case "RegionStatement":
+          return this.hasEarlyExit((stmt as RegionStatement).block);
+        default:
+          return false;
       }
+    });
+  }
+
+  // Também é necessário atualizar o método generateIfStmt para funcionar corretamente dentro de loops
+  private generateIfStmt(
+    node: IfStatement | ElifStatement,
+    entry: LLVMBasicBlock,
+    main: LLVMFunction,
+    sharedContinueLabel?: LLVMBasicBlock,
+  ): IRValue {
+    if (this.debug) {
+      entry.add(
+        `; DEBUG - LINE: ${node.loc.line} | RAW: ${node.loc.line_string}`,
+      );
     }
 
-    this.variables = outerVariables;
+    const cond = this.generateNode(node.condition as Expr, main);
+
+    const ifLabel = main.createBasicBlock(
+      "if_label" + main.nextBlockId(),
+    );
+    const elseLabel = main.createBasicBlock(
+      "else_label" + main.nextBlockId(),
+    );
+
+    // Both arms join here, also inside loops: statements after the `if`
+    // still belong to the loop body. An elif chain shares its first label.
+    const continueLabel = sharedContinueLabel ||
+      main.createBasicBlock("continue_label" + main.nextBlockId());
+
+    main.getCurrentBasicBlock().condBrInst(
+      cond,
+      ifLabel.label,
+      elseLabel.label,
+    );
+
+    // Generate if body
+    main.setCurrentBasicBlock(ifLabel);
+    for (const stmt of node.primary) {
+      this.generateNode(stmt, main);
+    }
+
+    // Handle if block termination
+    const currentIfBlock = main.getCurrentBasicBlock();
+    if (
+      !currentIfBlock.instructions.some((instr) =>
+        instr.trim().startsWith("ret ") ||
+        instr.trim().startsWith("br ")
+      )
+    ) {
+      currentIfBlock.brInst(continueLabel.label);
+    }
+
+    // Generate else body
+    main.setCurrentBasicBlock(elseLabel);
+
+    if (node.secondary !== null) {
+      if (node.secondary.kind === "ElifStatement") {
+        this.generateIfStmt(
+          node.secondary as ElifStatement,
+          elseLabel,
+          main,
+          continueLabel,
+        );
+      } else {
+        for (const stmt of node.secondary.primary) {
+          this.generateNode(stmt, main);
+        }
+
+        const currentElseBlock = main.getCurrentBasicBlock();
+        if (
+          !currentElseBlock.instructions.some((instr) =>
+            instr.trim().startsWith("ret ") ||
+            instr.trim().startsWith("br ")
+          )
+        ) {
+          currentElseBlock.brInst(continueLabel.label);
+        }
+      }
+    } else {
+      // Empty else case
+      elseLabel.brInst(continueLabel.label);
+    }
+
+    main.setCurrentBasicBlock(continueLabel);
+
+    return this.makeIrValue("0", "i32");
+  }
+
+  private makeReturnStatement(
+    node: ReturnStatement,
+    entry: LLVMBasicBlock,
+    main: LLVMFunction,
+  ): IRValue {
+    if (this.debug) {
+      entry.add(
+        `; DEBUG - LINE: ${node.loc.line} | RAW: ${node.loc.line_string}`,
+      );
+    }
+
+    const region = this.regionMarks[0];
+
+    if (node.expr.kind == "CallExpr") {
+      const expr = this.generateCallExpr(
+        node.expr as CallExpr,
+        main.getCurrentBasicBlock(),
+        main,
+        region == undefined,
+      );
+      const block = main.getCurrentBasicBlock();
+
+      // Self tail calls are already lowered to a jump
+      if (!this.isTerminated(block)) {
+        if (region) this.endRegion(region, block);
+        if (this.currentFunction?.retType == "void") block.retVoid();
+        else block.retInst(this.toReturnType(node.expr, expr, block));
+      }
+      return expr;
+    }
+
+    const expr = this.generateNode(node.expr, main);
+    const block = main.getCurrentBasicBlock();
+    if (region) this.endRegion(region, block);
+    block.retInst(this.toReturnType(node.expr, expr, block));
+    return expr;
+  }
+
+  // Plain strings returned from a `str` function are converted on the way out
+  private toReturnType(
+    node: Expr,
+    value: IRValue,
+    block: LLVMBasicBlock,
+  ): IRValue {
+    return this.currentFunction?.retType == FAT_STRING
+      ? this.toFatString(node, value, block)
+      : value;
+  }
+
+  private isTerminated(block: LLVMBasicBlock): boolean {
+    return block.instructions.some((instr) =>
+      instr.trim().startsWith("ret ") || instr.trim().startsWith("br ")
+    );
+  }
+
+  private generateFnDeclaration(
+    node: FunctionDeclaration,
+    _entry: LLVMBasicBlock,
+    _main: LLVMFunction,
+  ): IRValue {
+    const scopeInstance = this.instance.scopeStack;
+    this.instance.scopeStack = [node.scope!];
+
+    const funcName = node.id.value;
+    const getFunc = this.instance.availableFunctions
+      .get(funcName);
+
+    const outerVariables = new Map(this.variables);
+
+    const params = node.args.map((arg) => ({
+      name: arg.id.value,
+      type: arg.llvmType!,
+    }));
+
+    const func = new LLVMFunction(funcName, node.llvmType!, params);
+    const funcEntry = func.createBasicBlock("entry");
+    func.setCurrentBasicBlock(funcEntry);
+    this.attachDebugScope(func, node.loc.line);
+
+    const previousFunction = this.currentFunction;
+    const outerRegions = this.regionMarks;
+    this.regionMarks = [];
+    const paramSlots: IRValue[] = [];
+    const paramTypes: string[] = [];
+
+    for (
+      const arg of getFunc?.params! as {
+        name: string;
+        type: TypeInfo;
+        llvmType: string;
+      }[]
+    ) {
+      const argName = arg.name;
+      const argType = arg.llvmType!;
+
+      if (arg.type.isVector) {
+        this.declareVectorType(
+          argType.slice(0, -1),
+          this.instance.lookupSymbol(argName)!.llvmType as string,
+        );
+      }
+
+      if (arg.type.isSlice) {
+        this.declareSliceType(
+          argType,
+          new TypeChecker(this.reporter, this.instance).sliceElementType(
+            arg.type.baseType,
+          ),
+        );
+      }
+
+      const alloca = funcEntry.allocaInst(argType);
+
+      funcEntry.storeInst(
+        { value: `%${argName}`, type: argType },
+        alloca,
+      );
+
+      this.variables.set(argName, alloca);
+      paramSlots.push(alloca);
+      paramTypes.push(argType);
+    }
+
+    // Self tail calls store the new arguments and jump back here
+    let header: LLVMBasicBlock | null = null;
+    if (node.tailRecursive) {
+      header = func.createBasicBlock("tailrecurse" + func.nextBlockId());
+      funcEntry.brInst(header.label);
+      func.setCurrentBasicBlock(header);
+    }
+
+    this.currentFunction = {
+      name: funcName,
+      retType: node.llvmType!,
+      params: paramSlots,
+      paramTypes: paramTypes,
+      header: header,
+    };
+
+    // TODO
+    let _haveReturn = false;
+
+    try {
+      for (const stmt of node.block) {
+        this.generateNode(stmt, func);
+        if (stmt.kind == "ReturnStatement") {
+          _haveReturn = true;
+        }
+      }
+    } catch (error) {
+      throw error;
+    }
+
+    const currentBlock = func.getCurrentBasicBlock();
+    const hasTerminator = currentBlock.instructions.some(
+      (instr) =>
+        instr.trim().startsWith("ret ") || instr.trim().startsWith("br "),
+    );
+
+    if (!hasTerminator) {
+      if (node.llvmType === "void") {
+        currentBlock.retVoid();
+      } else {
+        currentBlock.retInst({
+          value: "0",
+          type: node.llvmType!,
+        });
+      }
+    }
+
+    this.variables = outerVariables;
+    this.currentFunction = previousFunction;
+    this.regionMarks = outerRegions;
+
+    if (this.debug) {
+      _entry.add(
+        `; DEBUG - LINE: ${node.loc.line} | RAW: ${node.loc.line_string}`,
+      );
+    }
+
+    this.instance.scopeStack = scopeInstance;
+    this.module.addFunction(func);
+    return { value: "0", type: "i32" } as IRValue;
+  }
+
+  private generateCallExpr(
+    node: CallExpr,
+    entry: LLVMBasicBlock,
+    main: LLVMFunction,
+    isReturned: boolean = false,
+  ): IRValue {
+    const funcName = node.callee.value;
+    let funcInfo = this.instance.availableFunctions
+      .get(funcName);
+
+    if (this.debug) {
+      entry.add(
+        `; DEBUG - LINE: ${node.loc.line} | RAW: ${node.loc.line_string}`,
+      );
+    }
+
+    funcInfo = funcInfo as StdLibFunction;
+
+    if (VECTOR_FUNCTIONS.has(funcName) && funcInfo?.isStdLib) {
+      return this.generateVectorCall(node, main);
+    }
+
+    if (SLICE_FUNCTIONS.has(funcName) && funcInfo?.isStdLib) {
+      return this.generateSliceCall(node, main);
+    }
+
+    if (SIMD_FUNCTIONS.has(funcName) && funcInfo?.isStdLib) {
+      return this.generateSimdCall(node, main);
+    }
+
+    if (ATOMIC_FUNCTIONS.has(funcName) && funcInfo?.isStdLib) {
+      return this.generateAtomicCall(node, main);
+    }
+
+    if (ALLOC_FUNCTIONS.has(funcName) && funcInfo?.isStdLib) {
+      return this.generateAllocCall(node, main);
+    }
+
+    if (FAT_STRING_FUNCTIONS.has(funcName) && funcInfo?.isStdLib) {
+      return this.generateFatStringCall(node, main);
+    }
+
+    if (funcName == "pool_new" && funcInfo?.isStdLib) {
+      return this.generatePoolNew(node, main);
+    }
+
+    // mnew("T") with a literal type name needs no string dispatch at runtime
+    const typeName = node.arguments[0]?.kind == "StringLiteral"
+      ? String(node.arguments[0].value)
+      : null;
+    if (
+      funcName == "mnew" && funcInfo?.isStdLib && typeName != null &&
+      new TypeChecker(this.reporter, this.instance).isSizedType(typeName)
+    ) {
+      return this.heapAllocate(
+        this.allocElementType(createTypeInfo(typeName)),
+        this.makeIrValue("1", "i64"),
+        false,
+        main.getCurrentBasicBlock(),
+      );
+    }
+
+    if (!this.declaredFuncs.has(funcName)) {
+      this.declaredFuncs.add(funcName);
+      if (funcInfo && (funcInfo as StdLibFunction).isStdLib != undefined) {
+        this.module.addExternal(funcInfo!.ir as string);
+      }
+    }
+
+    const actualFuncName = funcInfo && funcInfo.isStdLib
+      ? funcInfo.llvmName || funcInfo.name
+      : funcName;
+
+    const args: IRValue[] = [];
+    const argsTypes: string[] = [];
+    const declaredParams = funcInfo?.isStdLib
+      ? this.stdlibDeclaration(funcInfo)?.params
+      : undefined;
+
+    // Views come back from C through a slot passed first, like `str`
+    // results
+    const viewResult = funcInfo?.isStdLib && funcInfo.returnType.isSlice
+      ? main.allocaInEntry(funcInfo.llvmType as string)
+      : null;
+    if (viewResult) {
+      this.declareSliceType(
+        funcInfo.llvmType as string,
+        new TypeChecker(this.reporter, this.instance).sliceElementType(
+          funcInfo.returnType.baseType,
+        ),
+      );
+      args.push(viewResult);
+      argsTypes.push(viewResult.type);
+    }
+
+    for (let i = 0; i < node.arguments.length; i++) {
+      const arg = node.arguments[i];
+      if (this.debug) {
+        entry.add(
+          `; DEBUG - LINE: ${arg.loc.line} | RAW: ${arg.loc.line_string}`,
+        );
+      }
+      const argValue = this.generateNode(arg, main);
+
+      if (funcInfo?.isStdLib && funcInfo.params[i] == "view") {
+        for (const part of this.generateViewArgument(arg, argValue, main)) {
+          args.push(part);
+          argsTypes.push(part.type);
+        }
+        continue;
+      }
+
+      const value = arg.llvmType == FAT_STRING
+        ? this.toFatString(arg, argValue, main.getCurrentBasicBlock())
+        : this.toDeclaredParam(
+          argValue,
+          declaredParams?.[args.length],
+          main.getCurrentBasicBlock(),
+        );
+      args.push(value);
+      argsTypes.push(value.type);
+    }
+
+    const self = this.currentFunction;
+    if (node.tailCall && self?.header && self.name == funcName) {
+      return this.generateSelfTailCall(args, main);
+    }
+
+    const returnValue = main.getCurrentBasicBlock().callInst(
+      viewResult ? "void" : funcInfo.llvmType,
+      actualFuncName as string,
+      args,
+      argsTypes,
+      isReturned ? this.tailCallKind(funcInfo, argsTypes) : "",
+      viewResult ? "void" : this.calleeType(funcInfo),
+    );
+
+    if (viewResult) {
+      return main.getCurrentBasicBlock().loadInst(viewResult);
+    }
+
+    if (funcInfo?.returnType.baseType === "void") {
+      return this.makeIrValue("0", "i32");
+    }
+
+    return returnValue;
+  }
+
+  // Arguments are all evaluated before any parameter slot is overwritten,
+  // since they may read the current parameter values.
+  private generateSelfTailCall(args: IRValue[], main: LLVMFunction): IRValue {
+    const self = this.currentFunction!;
+    const block = main.getCurrentBasicBlock();
+
+    const values = args.map((arg, i) =>
+      block.convertValueToType(arg, self.paramTypes[i])
+    );
+    values.forEach((value, i) => block.storeInst(value, self.params[i]));
+    block.brInst(self.header!.label);
+
+    return this.makeIrValue("0", "i32");
+  }
+
+  // A variadic callee must be called through its full function type:
+  // called as `i32 @printf(...)` it is entered as a fixed-arity function,
+  // and on x86-64 %al no longer says how many vector registers hold
+  // arguments, so doubles print as garbage.
+  private calleeType(funcInfo: StdLibFunction): string {
+    const declaration = funcInfo.isVariadic
+      ? this.stdlibDeclaration(funcInfo)
+      : null;
+    return declaration
+      ? `${declaration.returnType} (${declaration.params.join(", ")})`
+      : funcInfo.llvmType as string;
+  }
+
+  // Return and parameter types of a stdlib function, read back from its
+  // `declare` line
+  private stdlibDeclaration(
+    funcInfo: StdLibFunction,
+  ): { returnType: string; params: string[] } | null {
+    const declaration = String(funcInfo.ir ?? "").match(
+      /^declare (.+?) @[\w.]+\((.*)\)/,
+    );
+    if (!declaration) return null;
+    return {
+      returnType: declaration[1],
+      params: declaration[2] ? declaration[2].split(", ") : [],
+    };
+  }
+
+  // C reads a numeric argument in the type it declares: `pow(x, 2)` with
+  // an int `x` has to pass a double
+  private toDeclaredParam(
+    value: IRValue,
+    param: string | undefined,
+    block: LLVMBasicBlock,
+  ): IRValue {
+    return param && param != value.type && this.isNumericType(param) &&
+        this.isNumericType(value.type)
+      ? block.convertValueToType(value, param)
+      : value;
+  }
+
+  private isNumericType(type: string): boolean {
+    return /^(i\d+|double|float)$/.test(type);
+  }
+
+  // `tail` promises LLVM the callee never touches the caller's stack, so
+  // only calls with scalar arguments get it: pointers, and views whose data
+  // may be a local array, are left alone. `musttail` additionally needs
+  // the callee prototype to match the caller exactly.
+  private tailCallKind(
+    funcInfo: StdLibFunction,
+    argsTypes: string[],
+  ): "" | "tail" | "musttail" {
+    const self = this.currentFunction;
+    if (!self) return "";
+
+    if (!argsTypes.every((type) => this.isNumericType(type))) {
+      return "";
+    }
+
+    if (
+      !funcInfo.isStdLib && !funcInfo.isVariadic &&
+      funcInfo.llvmType == self.retType &&
+      argsTypes.length == self.paramTypes.length &&
+      argsTypes.every((type, i) => type == self.paramTypes[i])
+    ) {
+      return "musttail";
+    }
+
+    return "tail";
+  }
+
+  private generateBinaryExpr(
+    expr: BinaryExpr,
+    entry: LLVMBasicBlock,
+    main: LLVMFunction,
+  ): IRValue {
+    if (expr.operator === "&&" || expr.operator === "||") {
+      return this.generateLogicalExprWithPhi(expr, entry, main);
+    }
+
+    const left = this.generateNode(expr.left, main);
+    const right = this.generateNode(expr.right, main);
+    // An operand (an `&&`, a bounds check) may have left us in a later block
+    entry = main.getCurrentBasicBlock();
+
+    if (this.debug) {
+      entry.add(
+        `; DEBUG - LINE: ${expr.loc.line} | RAW: ${expr.loc.line_string}`,
+      );
+    }
+
+    if (this.isSimdValue(left) || this.isSimdValue(right)) {
+      return this.generateSimdBinaryExpr(expr.operator, left, right, main);
+    }
+
+    switch (expr.operator) {
+      case "+":
+        return entry.addInst(left, right);
+      case "-":
+        return entry.subInst(left, right);
+      case "*":
+        return entry.mulInst(left, right);
+      case "**": {
+        const value = left;
+
+        if (Number(right.value) === 0) {
+          return this.makeIrValue("1", "i32");
+        }
+
+        if (Number(right.value) === 1) {
+          return value;
+        }
+
+        let result = left;
+        for (let i = 1; i < Number(right.value); i++) {
+          result = entry.mulInst(result, left);
+        }
+
+        return result;
+      }
+      case "/":
+        return entry.divInst(left, right);
+      case "==":
+        return entry.icmpInst("eq", left, right);
+      case "!=":
+        return entry.icmpInst("ne", left, right);
+      case "<":
+        return entry.icmpInst("slt", left, right);
+      case "<=":
+        return entry.icmpInst("sle", left, right);
+      case ">":
+        return entry.icmpInst("sgt", left, right);
+      case ">=":
+        return entry.icmpInst("sge", left, right);
+      case "%": {
+        // i % j = j - i * ( i / j )
+        // i left
+        // j right
+        const div = entry.divInst(left, right);
+        const mul = entry.mulInst(right, div);
+        return entry.subInst(left, mul);
+      }
+      default:
+        throw new Error(`Unsupported binary operator: ${expr.operator}`);
+    }
+  }
+
+  private generateLogicalExprWithPhi(
+    expr: BinaryExpr,
+    _entry: LLVMBasicBlock,
+    main: LLVMFunction,
+  ): IRValue {
+    const left = this.generateNode(expr.left, main);
+    const currentBlock = main.getCurrentBasicBlock();
+
+    const leftBool = left.type === "i1"
+      ? left
+      : currentBlock.icmpInst("ne", left, this.makeIrValue("0", left.type));
+
+    const rhsBlock = main.createBasicBlock(`log_rhs_${main.nextBlockId()}`);
+    const endBlock = main.createBasicBlock(`log_end_${main.nextBlockId()}`);
+
+    let shortCircuitValue: string;
+
+    if (expr.operator === "&&") {
+      shortCircuitValue = "0"; // false
+      currentBlock.condBrInst(leftBool, rhsBlock.label, endBlock.label);
+    } else if (expr.operator === "||") {
+      shortCircuitValue = "1"; // true
+      currentBlock.condBrInst(leftBool, endBlock.label, rhsBlock.label);
+    } else {
+      throw new Error(`Unsupported logical operator: ${expr.operator}`);
+    }
+
+    const leftBlock = currentBlock;
+    main.setCurrentBasicBlock(rhsBlock);
+    const right = this.generateNode(expr.right, main);
+
+    const rightBool = right.type === "i1"
+      ? right
+      : rhsBlock.icmpInst("ne", right, this.makeIrValue("0", right.type));
+
+    rhsBlock.brInst(endBlock.label);
+    const rightBlock = main.getCurrentBasicBlock();
+
+    main.setCurrentBasicBlock(endBlock);
+
+    const phiResult = endBlock.nextTemp();
+    endBlock.add(
+      `${phiResult} = phi i1 [ ${shortCircuitValue}, %${leftBlock.label} ], [ ${rightBool.value}, %${rightBlock.label} ]`,
+    );
+
+    return { value: phiResult, type: "i1" };
+  }
+
+  private generateIdentifier(
+    id: Identifier,
+    entry: LLVMBasicBlock,
+    _main: LLVMFunction,
+  ): IRValue {
+    if (!this.variables.get(id.value)) {
+      throw new Error(`Unknown variable: ${id.value}`);
+    }
+
+    const variable = this.variables.get(id.value) as IRValue;
+
+    if (this.debug) {
+      entry.add(
+        `; DEBUG - LINE: ${id.loc.line} | RAW: ${id.loc.line_string}`,
+      );
+    }
+
+    // Vectors are used through their slot, never loaded by value
+    if (this.isVectorValue(variable)) {
+      return variable;
+    }
+
+    return entry.loadInst({
+      value: variable.value as string,
+      type: variable.type as string,
+    });
+  }
+
+  private generateVariableDeclaration(
+    decl: VariableDeclaration,
+    entry: LLVMBasicBlock,
+    main: LLVMFunction,
+  ): IRValue {
+    // console.log(
+    //   "Erro!",
+    //   this.instance.lookupSymbol(decl.id.value)!,
+    //   decl.id.value,
+    //   this.instance.lookupSymbol(decl.value.value),
+    //   decl.value.value,
+    // );
+    if (decl.type.isVector) {
+      return this.generateVectorDeclaration(decl, main);
+    }
+
+    const type = this.instance.lookupSymbol(decl.id.value)!.llvmType;
+    const value = this.isSimdType(type as string)
+      ? this.generateSimdInitializer(decl.value, type as string, main)
+      : this.isAtomicDeclaration(decl)
+      ? this.atomicOperand(decl.value, type as string, main)
+      : decl.type.isArray && !decl.mutable &&
+          decl.value.kind == "ArrayLiteral"
+      ? this.generateArrayLiteral(decl.value as ArrayLiteral, entry, main, false)
+      : type == FAT_STRING
+      ? this.toFatString(
+        decl.value,
+        this.generateNode(decl.value, main),
+        main.getCurrentBasicBlock(),
+      )
+      : this.generateNode(decl.value, main);
+    entry = main.getCurrentBasicBlock();
+    let variable = this.makeIrValue("0", "i32");
+
+    if (decl.type.isArray) {
+      variable = value;
+    }
+
+    if (decl.type.isStruct) {
+      variable = value;
+    }
+
+    // In the entry block, so a declaration inside a loop reuses one slot
+    // instead of growing the stack on every iteration
+    if (!decl.type.isArray && !decl.type.isStruct) {
+      variable = main.allocaInEntry(type);
+    }
+
+    if (this.debug) {
+      entry.add(
+        `; DEBUG - LINE: ${decl.loc.line} | RAW: ${decl.loc.line_string}`,
+      );
+    }
+
+    // TODO: Improve this
+    if (value.type == "i8" || value.type == "i8*") {
+      if (decl.value.kind == "StringLiteral") {
+        entry.storeInst(
+          entry.getElementPtr(
+            `[${decl.value.value.length + 1} x i8]`,
+            value.value,
+          ),
+          variable,
+        );
+      } else {
+        entry.storeInst(value, variable);
+      }
+    }
+
+    if (!decl.type.isArray && !decl.type.isStruct) {
+      entry.storeInst(
+        this.isNumericType(value.type) && this.isNumericType(type as string)
+          ? entry.convertValueToType(value, type as string)
+          : { value: value.value, type: type as string },
+        variable,
+      );
+    }
+
+    this.variables.set(decl.id.value, variable);
+    return variable;
+  }
+
+  // Top-level scalars live in module globals so functions can share them.
+  // Constant initializers are emitted as static data (immutable ones as
+  // `internal constant`); anything else is zero-initialized and stored
+  // from main at the point of declaration.
+  private generateGlobalDeclaration(
+    decl: VariableDeclaration,
+    main: LLVMFunction,
+  ): IRValue {
+    if (decl.type.isVector) {
+      return this.generateVectorDeclaration(decl, main, true);
+    }
+
+    const arrayInitializer = decl.type.isArray &&
+        decl.value.kind == "ArrayLiteral"
+      ? this.constantArrayInitializer(decl.value as ArrayLiteral)
+      : null;
+
+    if (arrayInitializer != null) {
+      const arrayType = `[${decl.value.value.length} x ${decl.value.llvmType}]`;
+      const name = `@farpy.${decl.id.value}`;
+      const variable: IRValue = { value: name, type: `${arrayType}*` };
+
+      this.module.addGlobal(
+        `${name} = internal ${
+          decl.mutable ? "global" : "constant"
+        } ${arrayType} ${arrayInitializer}, align ${
+          main.getCurrentBasicBlock().getAlign(arrayType)
+        }`,
+      );
+      this.variables.set(decl.id.value, variable);
+      return variable;
+    }
+
+    if (decl.type.isArray || decl.type.isStruct) {
+      return this.generateNode(decl, main);
+    }
+
+    if (this.debug) {
+      main.getCurrentBasicBlock().add(
+        `; DEBUG - LINE: ${decl.loc.line} | RAW: ${decl.loc.line_string}`,
+      );
+    }
+
+    const type = this.instance.lookupSymbol(decl.id.value)!.llvmType as string;
+    const name = `@farpy.${decl.id.value}`;
+    const align = main.getCurrentBasicBlock().getAlign(type);
+    const simd = this.isSimdType(type);
+    const initializer = simd
+      ? this.simdConstant(decl.value, type)
+      : this.constantInitializer(decl.value, type);
+    const variable: IRValue = {
+      value: name,
+      type: type == "ptr" ? type : `${type}*`,
+    };
+
+    // Atomics are written through atomic_* calls even when not `mut`
+    const writable = decl.mutable || this.isAtomicDeclaration(decl);
+
+    if (initializer != null) {
+      this.module.addGlobal(
+        `${name} = internal ${
+          writable ? "global" : "constant"
+        } ${type} ${initializer}, align ${align}`,
+      );
+    } else {
+      this.module.addGlobal(
+        `${name} = internal global ${type} zeroinitializer, align ${align}`,
+      );
+
+      const value = simd
+        ? this.generateSimdInitializer(decl.value, type, main)
+        : this.isAtomicDeclaration(decl)
+        ? this.atomicOperand(decl.value, type, main)
+        : type == FAT_STRING
+        ? this.toFatString(
+          decl.value,
+          this.generateNode(decl.value, main),
+          main.getCurrentBasicBlock(),
+        )
+        : this.generateNode(decl.value, main);
+      const block = main.getCurrentBasicBlock();
+
+      block.storeInst(
+        this.isNumericType(value.type) && this.isNumericType(type)
+          ? block.convertValueToType(value, type)
+          : { value: value.value, type: type },
+        variable,
+      );
+    }
+
+    this.variables.set(decl.id.value, variable);
+    return variable;
+  }
+
+  // A vector is a `{ T* data, i64 len, i64 cap }` slot: a stack alloca, or
+  // a module global at top level. The initializer literal is pushed after
+  // a single reserve.
+  private generateVectorDeclaration(
+    decl: VariableDeclaration,
+    main: LLVMFunction,
+    global: boolean = false,
+  ): IRValue {
+    const vectorType = decl.llvmType as string;
+    const elementType = this.instance.lookupSymbol(decl.id.value)!
+      .llvmType as string;
+    this.declareVectorType(vectorType, elementType);
+
+    let vector: IRValue;
+
+    if (global) {
+      vector = { value: `@farpy.${decl.id.value}`, type: `${vectorType}*` };
+      this.module.addGlobal(
+        `${vector.value} = internal global ${vectorType} zeroinitializer, align 8`,
+      );
+    } else {
+      vector = main.allocaInEntry(vectorType);
+      main.getCurrentBasicBlock().storeInst(
+        { value: "zeroinitializer", type: vectorType },
+        vector,
+      );
+    }
+
+    this.variables.set(decl.id.value, vector);
+
+    const elements = (decl.value as ArrayLiteral).value;
+    if (elements.length > 0) {
+      this.generateVectorReserve(
+        vector,
+        this.makeIrValue(String(elements.length), "i64"),
+        main,
+      );
+      for (const element of elements) {
+        this.generateVectorPush(vector, this.generateNode(element, main), main);
+      }
+    }
+
+    return vector;
+  }
+
+  private generateVectorCall(node: CallExpr, main: LLVMFunction): IRValue {
+    const vector = this.generateNode(node.arguments[0], main);
+
+    switch (node.callee.value) {
+      case "vec_push":
+        this.generateVectorPush(
+          vector,
+          this.generateNode(node.arguments[1], main),
+          main,
+        );
+        break;
+      case "vec_reserve":
+        this.generateVectorReserve(
+          vector,
+          this.generateNode(node.arguments[1], main),
+          main,
+        );
+        break;
+      case "vec_len":
+        return main.getCurrentBasicBlock().getStructField(vector, 1, "i64");
+      case "vec_cap":
+        return main.getCurrentBasicBlock().getStructField(vector, 2, "i64");
+      case "vec_clear":
+        main.getCurrentBasicBlock().setStructField(
+          vector,
+          1,
+          "i64",
+          this.makeIrValue("0", "i64"),
+        );
+        break;
+      case "vec_free": {
+        const block = main.getCurrentBasicBlock();
+        this.declareRuntimeFunction(
+          "vec_release",
+          "declare void @vec_release(i8*)",
+        );
+        block.callInst(
+          "void",
+          "vec_release",
+          [block.convertValueToType(vector, "i8*")],
+          ["i8*"],
+        );
+        break;
+      }
+    }
+
+    return this.makeIrValue("0", "i32");
+  }
+
+  // Fast path stores straight into the buffer; only a full vector takes
+  // the out-of-line vec_grow call.
+  private generateVectorPush(
+    vector: IRValue,
+    value: IRValue,
+    main: LLVMFunction,
+  ): void {
+    const elementType = this.vectorTypes.get(vector.type.slice(0, -1))!;
+    const block = main.getCurrentBasicBlock();
+    const len = block.getStructField(vector, 1, "i64");
+    const cap = block.getStructField(vector, 2, "i64");
+    const full = block.icmpInst("eq", len, cap);
+    const next = block.addInst(len, this.makeIrValue("1", "i64"));
+
+    this.generateVectorGrow(vector, next, full, main);
+
+    const store = main.getCurrentBasicBlock();
+    const data = store.getStructField(vector, 0, `${elementType}*`);
+    store.storeInst(
+      store.convertValueToType(value, elementType),
+      store.getPointerElementPtr(data, len),
+    );
+    store.setStructField(vector, 1, "i64", next);
+  }
+
+  private generateVectorReserve(
+    vector: IRValue,
+    count: IRValue,
+    main: LLVMFunction,
+  ): void {
+    const block = main.getCurrentBasicBlock();
+    const wanted = block.convertValueToType(count, "i64");
+    const cap = block.getStructField(vector, 2, "i64");
+    const needsGrow = block.icmpInst("sgt", wanted, cap);
+
+    this.generateVectorGrow(vector, wanted, needsGrow, main);
+  }
+
+  // Leaves the current block pointing at the join after the grow call.
+  private generateVectorGrow(
+    vector: IRValue,
+    minCap: IRValue,
+    needsGrow: IRValue,
+    main: LLVMFunction,
+  ): void {
+    const elementType = this.vectorTypes.get(vector.type.slice(0, -1))!;
+    const block = main.getCurrentBasicBlock();
+    const growBlock = main.createBasicBlock("vec.grow" + main.nextBlockId());
+    const contBlock = main.createBasicBlock("vec.cont" + main.nextBlockId());
+
+    block.condBrInst(needsGrow, growBlock.label, contBlock.label);
+
+    this.declareRuntimeFunction(
+      "vec_grow",
+      "declare void @vec_grow(i8*, i64, i64)",
+    );
+    main.setCurrentBasicBlock(growBlock);
+    growBlock.callInst(
+      "void",
+      "vec_grow",
+      [
+        growBlock.convertValueToType(vector, "i8*"),
+        {
+          value:
+            `ptrtoint (${elementType}* getelementptr (${elementType}, ${elementType}* null, i32 1) to i64)`,
+          type: "i64",
+        },
+        minCap,
+      ],
+      ["i8*", "i64", "i64"],
+    );
+    growBlock.brInst(contBlock.label);
+
+    main.setCurrentBasicBlock(contBlock);
+  }
+
+  private generateSliceCall(node: CallExpr, main: LLVMFunction): IRValue {
+    const source = this.generateAddressable(node.arguments[0], main);
+
+    if (node.callee.value == "slice_len") {
+      return main.getCurrentBasicBlock().extractValueInst(source, 1, "i64");
+    }
+
+    const start = this.generateNode(node.arguments[1], main);
+    const end = this.generateNode(node.arguments[2], main);
+    const block = main.getCurrentBasicBlock();
+
+    // Pointer to the first element of whatever is being sliced
+    let data: IRValue;
+    if (this.isVectorValue(source)) {
+      const elementType = this.vectorTypes.get(source.type.slice(0, -1))!;
+      data = block.getStructField(source, 0, `${elementType}*`);
+    } else if (this.sliceTypes.has(source.type)) {
+      const elementType = this.sliceTypes.get(source.type)!;
+      data = block.extractValueInst(source, 0, `${elementType}*`);
+    } else if (source.type.startsWith("[")) {
+      data = block.getArrayElementPtr(source, this.makeIrValue("0", "i32"));
+    } else {
+      data = source;
+    }
+
+    const from = block.convertValueToType(start, "i64");
+    const to = block.convertValueToType(end, "i64");
+
+    // --bounds-check: 0 <= start <= end <= len. Compared unsigned, so a
+    // negative start or end fails too.
+    const length = this.boundsCheck ? this.boundsLength(source, block) : null;
+    if (length) {
+      this.boundsCheckStats.sites++;
+      this.boundsCheckStats.checked++;
+      const endInBounds = block.icmpInst("ule", to, length);
+      this.emitBoundsCheck(
+        block.andInst(endInBounds, block.icmpInst("ule", from, to)),
+        block.selectInst(endInBounds, from, to),
+        length,
+        node.loc.line,
+        main,
+      );
+    }
+
+    // An end before the start gives an empty view, as str_slice does,
+    // instead of a negative length
+    const current = main.getCurrentBasicBlock();
+    const count = current.selectInst(
+      current.icmpInst("slt", to, from),
+      this.makeIrValue("0", "i64"),
+      current.subInst(to, from),
+    );
+
+    return this.makeSlice(
+      node.llvmType as string,
+      current.getPointerElementPtr(data, from),
+      count,
+      current,
+    );
+  }
+
+  // C functions take a view as (pointer, length). Plain strings are
+  // measured on the way in; literals at compile time and `str` values
+  // carry their length.
+  private generateViewArgument(
+    node: Expr,
+    value: IRValue,
+    main: LLVMFunction,
+  ): IRValue[] {
+    const block = main.getCurrentBasicBlock();
+
+    if (this.sliceTypes.has(value.type)) {
+      return [
+        block.extractValueInst(value, 0, "i8*"),
+        block.extractValueInst(value, 1, "i64"),
+      ];
+    }
+
+    if (value.type == FAT_STRING) {
+      return [
+        this.fatStringData(this.fatStringSlot(node, value, main), main),
+        main.getCurrentBasicBlock().extractValueInst(value, 1, "i64"),
+      ];
+    }
+
+    if (node.kind == "StringLiteral") {
+      return [
+        value,
+        this.makeIrValue(String(stringByteLength(node.value)), "i64"),
+      ];
+    }
+
+    this.declareRuntimeFunction("strlen", "declare i64 @strlen(i8*)");
+    return [value, block.callInst("i64", "strlen", [value], ["i8*"])];
+  }
+
+  private makeSlice(
+    sliceType: string,
+    data: IRValue,
+    length: IRValue,
+    block: LLVMBasicBlock,
+  ): IRValue {
+    this.declareSliceType(sliceType, data.type.slice(0, -1));
+
+    const withData = block.insertValueInst(
+      { value: "undef", type: sliceType },
+      data,
+      0,
+    );
+    return block.insertValueInst(withData, length, 1);
+  }
+
+  private declareSliceType(sliceType: string, elementType: string): void {
+    if (this.sliceTypes.has(sliceType)) return;
+
+    this.sliceTypes.set(sliceType, elementType);
+    this.module.addGlobal(`${sliceType} = type { ${elementType}*, i64 }`);
+  }
+
+  // str_len and cstr read the value in place; str_from and str_cat take
+  // views and fill in a result slot.
+  private generateFatStringCall(node: CallExpr, main: LLVMFunction): IRValue {
+    const funcName = node.callee.value;
+    const arg = node.arguments[0] as Expr;
+    const value = this.generateNode(arg, main);
+
+    if (funcName == "str_len" || funcName == "cstr") {
+      const block = main.getCurrentBasicBlock();
+      const fat = this.toFatString(arg, value, block);
+      return funcName == "str_len"
+        ? block.extractValueInst(fat, 1, "i64")
+        : this.fatStringData(this.fatStringSlot(arg, fat, main), main);
+    }
+
+    const result = main.allocaInEntry(FAT_STRING);
+    const args: IRValue[] = [result];
+    args.push(...this.generateViewArgument(arg, value, main));
+    for (const next of node.arguments.slice(1) as Expr[]) {
+      const nextValue = this.generateNode(next, main);
+      args.push(...this.generateViewArgument(next, nextValue, main));
+    }
+
+    const funcInfo = this.instance.availableFunctions
+      .get(funcName) as StdLibFunction;
+    this.declareRuntimeFunction(funcName, funcInfo.ir as string);
+
+    const block = main.getCurrentBasicBlock();
+    block.callInst("void", funcName, args, args.map((a) => a.type));
+    return block.loadInst(result);
+  }
+
+  // A literal becomes a constant pointing at its global, length included
+  private fatStringConstant(node: StringLiteral): string {
+    const label = createStringGlobal(this.module, node.value);
+    const length = stringByteLength(node.value);
+    const arrayType = `[${length + 1} x i8]`;
+
+    return `{ i8* getelementptr inbounds (${arrayType}, ${arrayType}* ${label}, i32 0, i32 0), i64 ${length}, [16 x i8] zeroinitializer }`;
+  }
+
+  // Plain strings borrow their bytes and are measured once, here
+  private toFatString(
+    node: Expr,
+    value: IRValue,
+    block: LLVMBasicBlock,
+  ): IRValue {
+    if (value.type == FAT_STRING) return value;
+
+    if (node.kind == "StringLiteral") {
+      return {
+        value: this.fatStringConstant(node as StringLiteral),
+        type: FAT_STRING,
+      };
+    }
+
+    this.declareRuntimeFunction("strlen", "declare i64 @strlen(i8*)");
+    const length = block.callInst("i64", "strlen", [value], ["i8*"]);
+    const withData = block.insertValueInst(
+      { value: "zeroinitializer", type: FAT_STRING },
+      value,
+      0,
+    );
+    return block.insertValueInst(withData, length, 1);
+  }
+
+  // Inline text lives in the value itself, so reading it needs an address:
+  // the variable when there is one, a stack copy otherwise.
+  private fatStringSlot(
+    node: Expr,
+    value: IRValue,
+    main: LLVMFunction,
+  ): IRValue {
+    const variable = node.kind == "Identifier"
+      ? this.variables.get(node.value)
+      : undefined;
+    if (variable?.type == `${FAT_STRING}*`) return variable;
+
+    const slot = main.allocaInEntry(FAT_STRING);
+    main.getCurrentBasicBlock().storeInst(value, slot);
+    return slot;
+  }
+
+  private fatStringData(slot: IRValue, main: LLVMFunction): IRValue {
+    const block = main.getCurrentBasicBlock();
+    const data = block.getStructField(slot, 0, "i8*");
+    const small = block.getArrayElementPtr(
+      block.getStructFieldPtr(slot, 2, "[16 x i8]"),
+      this.makeIrValue("0", "i32"),
+    );
+    const inline = block.icmpInst("eq", data, { value: "null", type: "i8*" });
+    return block.selectInst(inline, small, data);
+  }
+
+  // A SIMD declaration takes one literal per lane, a single scalar to
+  // broadcast, or another value of the same type.
+  private generateSimdInitializer(
+    node: Expr,
+    type: string,
+    main: LLVMFunction,
+  ): IRValue {
+    const constant = this.simdConstant(node, type);
+    if (constant != null) {
+      return { value: constant, type };
+    }
+
+    if (node.kind != "ArrayLiteral") {
+      const value = this.generateNode(node, main);
+      return value.type == type
+        ? value
+        : this.splatScalar(value, type, main.getCurrentBasicBlock());
+    }
+
+    const element = type.match(/^<\d+ x (\w+)>$/)![1];
+    let vector: IRValue = { value: "undef", type };
+
+    (node as ArrayLiteral).value.forEach((lane, index) => {
+      const value = this.generateNode(lane, main);
+      const block = main.getCurrentBasicBlock();
+      vector = block.insertElementInst(
+        vector,
+        block.convertValueToType(value, element),
+        { value: String(index), type: "i32" },
+      );
+    });
+
+    return vector;
+  }
+
+  // `<float 1.0, ...>` when every lane is a literal. f32 lanes are rounded
+  // to float and written in hex, the only form LLVM takes for values that
+  // a decimal float literal cannot state exactly.
+  private simdConstant(node: Expr, type: string): string | null {
+    const [, lanes, element] = type.match(/^<(\d+) x (\w+)>$/)!;
+    const values = node.kind == "ArrayLiteral"
+      ? (node as ArrayLiteral).value
+      : new Array<Expr>(Number(lanes)).fill(node);
+    const constants: string[] = [];
+
+    for (const value of values) {
+      const constant = this.constantInitializer(
+        value,
+        element == "float" ? "double" : element,
+      );
+      if (constant == null) return null;
+
+      if (element != "float") {
+        constants.push(`${element} ${constant}`);
+        continue;
+      }
 
-    if (this.debug) {
-      _entry.add(
-        `; DEBUG - LINE: ${node.loc.line} | RAW: ${node.loc.line_string}`,
+      const bits = new DataView(new ArrayBuffer(8));
+      bits.setFloat64(0, Math.fround(Number(constant)));
+      constants.push(
+        `float 0x${
+          bits.getBigUint64(0).toString(16).toUpperCase().padStart(16, "0")
+        }`,
       );
     }
 
-    this.instance.scopeStack = scopeInstance;
-    this.module.addFunction(func);
-    return { value: "0", type: "i32" } as IRValue;
+    return `<${constants.join(", ")}>`;
   }
 
-  private generateCallExpr(
-    node: CallExpr,
-    entry: LLVMBasicBlock,
+  private generateSimdBinaryExpr(
+    operator: string,
+    left: IRValue,
+    right: IRValue,
     main: LLVMFunction,
   ): IRValue {
-    const funcName = node.callee.value;
-    let funcInfo = this.instance.availableFunctions
-      .get(funcName);
+    const block = main.getCurrentBasicBlock();
+    const type = this.isSimdValue(left) ? left.type : right.type;
+    const lhs = this.isSimdValue(left)
+      ? left
+      : this.splatScalar(left, type, block);
+    const rhs = this.isSimdValue(right)
+      ? right
+      : this.splatScalar(right, type, block);
 
-    if (this.debug) {
-      entry.add(
-        `; DEBUG - LINE: ${node.loc.line} | RAW: ${node.loc.line_string}`,
-      );
+    switch (operator) {
+      case "+":
+        return block.addInst(lhs, rhs);
+      case "-":
+        return block.subInst(lhs, rhs);
+      case "*":
+        return block.mulInst(lhs, rhs);
+      case "/":
+        return block.divInst(lhs, rhs);
+      default:
+        throw new Error(`Unsupported SIMD operator: ${operator}`);
     }
+  }
 
-    funcInfo = funcInfo as StdLibFunction;
+  private generateSimdCall(node: CallExpr, main: LLVMFunction): IRValue {
+    const funcName = node.callee.value;
+    const perType = funcName.match(/^(\w+)_(load|store|splat)$/);
 
-    if (!this.declaredFuncs.has(funcName)) {
-      this.declaredFuncs.add(funcName);
-      if (funcInfo && (funcInfo as StdLibFunction).isStdLib != undefined) {
-        this.module.addExternal(funcInfo!.ir as string);
-      }
+    if (perType?.[2] == "load" || perType?.[2] == "store") {
+      return this.generateSimdMemoryAccess(node, main);
     }
 
-    const actualFuncName = funcInfo && funcInfo.isStdLib
-      ? funcInfo.name
-      : funcName;
-
-    const args: IRValue[] = [];
-    const argsTypes: string[] = [];
+    const args = node.arguments
+      .filter((arg) => arg.kind != "ArrayLiteral")
+      .map((arg) => this.generateNode(arg, main));
+    const block = main.getCurrentBasicBlock();
 
-    for (let i = 0; i < node.arguments.length; i++) {
-      const arg = node.arguments[i];
-      if (this.debug) {
-        entry.add(
-          `; DEBUG - LINE: ${arg.loc.line} | RAW: ${arg.loc.line_string}`,
+    switch (funcName) {
+      case "shuffle": {
+        const mask = (node.arguments[2] as ArrayLiteral).value
+          .map((lane) => Number(lane.value));
+        return block.shuffleVectorInst(args[0], args[1], mask);
+      }
+      case "with_lane": {
+        const element = args[0].type.match(/^<\d+ x (\w+)>$/)![1];
+        return block.insertElementInst(
+          args[0],
+          block.convertValueToType(args[2], element),
+          args[1],
         );
       }
-      const argValue = this.generateNode(arg, main);
+      case "reduce_add":
+      case "reduce_mul":
+      case "reduce_min":
+      case "reduce_max":
+        return this.generateSimdReduce(funcName.slice(7), args[0], block);
+      default: // <type>_splat
+        return this.splatScalar(args[0], node.llvmType as string, block);
+    }
+  }
 
-      args.push(argValue);
-      argsTypes.push(argValue.type);
+  // f32x4_load(a, i) reads a[i..i+4) as one vector and f32x4_store(a, i, v)
+  // writes it back. float lanes come from float (double) arrays and are
+  // narrowed on load, widened on store; integer lanes follow the same
+  // rule between i32 and i64. The access is aligned to the whole vector
+  // when the index is a literal multiple of the lane count.
+  private generateSimdMemoryAccess(
+    node: CallExpr,
+    main: LLVMFunction,
+  ): IRValue {
+    const store = node.callee.value.endsWith("_store");
+    const array = this.generateAddressable(node.arguments[0], main);
+    const index = this.generateNode(node.arguments[1], main);
+    const type = store
+      ? node.arguments[2].llvmType as string
+      : node.llvmType as string;
+    const [, lanes] = type.match(/^<(\d+) x (\w+)>$/)!;
+    const arrayType = array.type.match(/^\[(\d+) x (.+)\]\*$/);
+
+    if (!arrayType) {
+      const message =
+        `Function '${node.callee.value}' needs a fixed-size array declared in scope`;
+      this.reporter.addError(node.arguments[0].loc, message);
+      throw new Error(message);
     }
 
-    const returnValue = main.getCurrentBasicBlock().callInst(
-      funcInfo.llvmType,
-      actualFuncName as string,
-      args,
-      argsTypes,
+    const memoryType = `<${lanes} x ${arrayType[2]}>`;
+    if (this.boundsCheck) {
+      this.checkSimdBounds(node, index, Number(arrayType[1]), main);
+    }
+
+    const value = store ? this.generateNode(node.arguments[2], main) : null;
+    const block = main.getCurrentBasicBlock();
+    const pointer = block.convertValueToType(
+      block.getArrayElementPtr(array, index),
+      `${memoryType}*`,
     );
 
-    if (funcInfo?.returnType.baseType === "void") {
+    const elementAlign = block.getAlign(arrayType[2]);
+    const vectorAlign = Math.min(
+      block.getAlign(memoryType),
+      block.getAlign(array.type),
+    );
+    const align = node.arguments[1].kind == "IntLiteral" &&
+        Number(node.arguments[1].value) % Number(lanes) == 0
+      ? vectorAlign
+      : elementAlign;
+
+    if (value) {
+      block.storeInst(
+        block.convertVectorInst(value, memoryType),
+        pointer,
+        align,
+      );
       return this.makeIrValue("0", "i32");
     }
 
-    return returnValue;
+    return block.convertVectorInst(block.loadInst(pointer, align), type);
   }
 
-  private generateBinaryExpr(
-    expr: BinaryExpr,
-    entry: LLVMBasicBlock,
+  // Under --bounds-check a vector access needs its last lane in range:
+  // `index <= length - lanes`, as one unsigned compare.
+  private checkSimdBounds(
+    node: CallExpr,
+    index: IRValue,
+    length: number,
     main: LLVMFunction,
-  ): IRValue {
-    if (expr.operator === "&&" || expr.operator === "||") {
-      return this.generateLogicalExprWithPhi(expr, entry, main);
+  ): void {
+    const type = node.callee.value.match(/^(\w+)_(load|store)$/)![1];
+    const lanes = SimdTypes[type].lanes;
+    const name = node.arguments[0].value;
+    this.boundsCheckStats.sites++;
+
+    if (length < lanes) {
+      const message =
+        `Array '${name}' of length ${length} is shorter than '${type}'`;
+      this.reporter.addError(node.arguments[0].loc, message);
+      throw new Error(message);
     }
 
-    const left = this.generateNode(expr.left, main);
-    const right = this.generateNode(expr.right, main);
+    if (node.arguments[1].kind == "IntLiteral") {
+      const first = Number(node.arguments[1].value);
+      if (first >= 0 && first + lanes <= length) {
+        this.boundsCheckStats.proven++;
+        return;
+      }
 
-    if (this.debug) {
-      entry.add(
-        `; DEBUG - LINE: ${expr.loc.line} | RAW: ${expr.loc.line_string}`,
-      );
+      const message = `Lanes ${first}..${
+        first + lanes - 1
+      } are out of bounds for '${name}' of length ${length}`;
+      this.reporter.addError(node.arguments[1].loc, message);
+      throw new Error(message);
     }
 
-    switch (expr.operator) {
-      case "+":
-        return entry.addInst(left, right);
-      case "-":
-        return entry.subInst(left, right);
-      case "*":
-        return entry.mulInst(left, right);
-      case "**": {
-        const value = left;
+    this.boundsCheckStats.checked++;
+    const block = main.getCurrentBasicBlock();
+    const position = block.convertValueToType(index, "i64");
+    this.emitBoundsCheck(
+      block.icmpInst("ule", position, {
+        value: String(length - lanes),
+        type: "i64",
+      }),
+      position,
+      { value: String(length), type: "i64" },
+      node.loc.line,
+      main,
+    );
+  }
 
-        if (Number(right.value) === 0) {
-          return this.makeIrValue("1", "i32");
-        }
+  // Horizontal reductions go through the llvm.vector.reduce intrinsics.
+  // Float sums and products are marked `reassoc` so they may be computed
+  // as a tree rather than strictly lane by lane.
+  private generateSimdReduce(
+    kind: string,
+    vector: IRValue,
+    block: LLVMBasicBlock,
+  ): IRValue {
+    const [, lanes, element] = vector.type.match(/^<(\d+) x (\w+)>$/)!;
+    const float = element == "float" || element == "double";
+    const bits = element == "float" || element == "i32" ? 32 : 64;
+    const operations: Record<string, string> = float
+      ? { add: "fadd", mul: "fmul", min: "fmin", max: "fmax" }
+      : { add: "add", mul: "mul", min: "smin", max: "smax" };
+    const operation = operations[kind];
+    const name = `llvm.vector.reduce.${operation}.v${lanes}${
+      float ? "f" : "i"
+    }${bits}`;
+    const start = float && (kind == "add" || kind == "mul")
+      ? `${element} ${kind == "add" ? "-0.0" : "1.0"}, `
+      : "";
+
+    this.declareRuntimeFunction(
+      name,
+      `declare ${element} @${name}(${start ? `${element}, ` : ""}${vector.type})`,
+    );
 
-        if (Number(right.value) === 1) {
-          return value;
-        }
+    const tmp = block.nextTemp();
+    block.add(
+      `${tmp} = call ${start ? "reassoc " : ""}${element} @${name}(${start}${vector.type} ${vector.value})`,
+    );
+    return this.simdLaneValue({ value: tmp, type: element }, block);
+  }
 
-        let result = left;
-        for (let i = 1; i < Number(right.value); i++) {
-          result = entry.mulInst(result, left);
-        }
+  private splatScalar(
+    value: IRValue,
+    type: string,
+    block: LLVMBasicBlock,
+  ): IRValue {
+    const element = type.match(/^<\d+ x (\w+)>$/)![1];
+    return block.splatInst(block.convertValueToType(value, element), type);
+  }
 
-        return result;
-      }
-      case "/":
-        return entry.divInst(left, right);
-      case "==":
-        return entry.icmpInst("eq", left, right);
-      case "!=":
-        return entry.icmpInst("ne", left, right);
-      case "<":
-        return entry.icmpInst("slt", left, right);
-      case "<=":
-        return entry.icmpInst("sle", left, right);
-      case ">":
-        return entry.icmpInst("sgt", left, right);
-      case ">=":
-        return entry.icmpInst("sge", left, right);
-      case "%": {
-        // i % j = j - i * ( i / j )
-        // i left
-        // j right
-        const div = entry.divInst(left, right);
-        const mul = entry.mulInst(right, div);
-        return entry.subInst(left, mul);
-      }
-      default:
-        throw new Error(`Unsupported binary operator: ${expr.operator}`);
+  // f32 lanes are read back as Farpy floats (double)
+  private simdLaneValue(lane: IRValue, block: LLVMBasicBlock): IRValue {
+    return lane.type == "float"
+      ? block.convertValueToType(lane, "double")
+      : lane;
+  }
+
+  private isSimdValue(value: IRValue): boolean {
+    return this.isSimdType(value.type);
+  }
+
+  // Each atomic_* call is a single instruction on the variable's slot
+  private generateAtomicCall(node: CallExpr, main: LLVMFunction): IRValue {
+    const args = node.arguments;
+    const ordering = ATOMIC_ORDERINGS[args[args.length - 1].value];
+
+    if (node.callee.value == "atomic_fence") {
+      main.getCurrentBasicBlock().fenceInst(ordering);
+      return this.makeIrValue("0", "i32");
+    }
+
+    // A global `atomic<ptr>` slot is typed `ptr*`; it is just `ptr`
+    let slot = this.variables.get(args[0].value)!;
+    if (slot.type == "ptr*") slot = { value: slot.value, type: "ptr" };
+    const element = slot.type == "ptr" ? "ptr" : slot.type.slice(0, -1);
+
+    const values = args.slice(1, -1).map((arg) =>
+      this.atomicOperand(arg, element, main)
+    );
+    const block = main.getCurrentBasicBlock();
+
+    switch (node.callee.value) {
+      case "atomic_load":
+        return block.atomicLoadInst(slot, ordering);
+      case "atomic_store":
+        block.atomicStoreInst(values[0], slot, ordering);
+        return this.makeIrValue("0", "i32");
+      case "atomic_exchange":
+        return block.atomicRMWInst("xchg", slot, values[0], ordering);
+      case "atomic_fetch_add":
+        return block.atomicRMWInst("add", slot, values[0], ordering);
+      case "atomic_fetch_sub":
+        return block.atomicRMWInst("sub", slot, values[0], ordering);
+      default: // atomic_cas
+        return block.cmpXchgInst(slot, values[0], values[1], ordering);
     }
   }
 
-  private generateLogicalExprWithPhi(
-    expr: BinaryExpr,
-    _entry: LLVMBasicBlock,
+  // Integers are widened or narrowed to the atomic's width; any pointer
+  // is stored as `ptr`.
+  private atomicOperand(
+    node: Expr,
+    type: string,
     main: LLVMFunction,
   ): IRValue {
-    const left = this.generateNode(expr.left, main);
-    const currentBlock = main.getCurrentBasicBlock();
+    const value = this.generateNode(node, main);
+    if (type == "ptr") return { value: value.value, type };
+    return main.getCurrentBasicBlock().convertValueToType(value, type);
+  }
 
-    const leftBool = left.type === "i1"
-      ? left
-      : currentBlock.icmpInst("ne", left, this.makeIrValue("0", left.type));
+  private isAtomicDeclaration(decl: VariableDeclaration): boolean {
+    return Object.hasOwn(AtomicTypes, String(decl.type.baseType)) &&
+      !decl.type.isPointer && !decl.type.isArray;
+  }
 
-    const rhsBlock = main.createBasicBlock(`log_rhs_${main.nextBlockId()}`);
-    const endBlock = main.createBasicBlock(`log_end_${main.nextBlockId()}`);
+  private isSimdType(type: string): boolean {
+    return /^<\d+ x \w+>$/.test(type);
+  }
 
-    let shortCircuitValue: string;
+  // Arrays and vectors are indexed and sliced in place rather than loaded
+  // (and copied) by value.
+  private generateAddressable(node: Expr, main: LLVMFunction): IRValue {
+    const variable = node.kind == "Identifier"
+      ? this.variables.get(node.value)
+      : undefined;
 
-    if (expr.operator === "&&") {
-      shortCircuitValue = "0"; // false
-      currentBlock.condBrInst(leftBool, rhsBlock.label, endBlock.label);
-    } else if (expr.operator === "||") {
-      shortCircuitValue = "1"; // true
-      currentBlock.condBrInst(leftBool, endBlock.label, rhsBlock.label);
-    } else {
-      throw new Error(`Unsupported logical operator: ${expr.operator}`);
+    if (variable && /^\[\d+ x .+\]\*$/.test(variable.type)) {
+      return variable;
     }
 
-    const leftBlock = currentBlock;
-    main.setCurrentBasicBlock(rhsBlock);
-    const right = this.generateNode(expr.right, main);
-
-    const rightBool = right.type === "i1"
-      ? right
-      : rhsBlock.icmpInst("ne", right, this.makeIrValue("0", right.type));
+    return this.generateNode(node, main);
+  }
 
-    rhsBlock.brInst(endBlock.label);
-    const rightBlock = main.getCurrentBasicBlock();
+  private getCharTable(): string {
+    if (this.charTable) return this.charTable;
 
-    main.setCurrentBasicBlock(endBlock);
+    const chars: string[] = [];
+    for (let c = 0; c < 256; c++) {
+      chars.push(`[2 x i8] [i8 ${c}, i8 0]`);
+    }
 
-    const phiResult = endBlock.nextTemp();
-    endBlock.add(
-      `${phiResult} = phi i1 [ ${shortCircuitValue}, %${leftBlock.label} ], [ ${rightBool.value}, %${rightBlock.label} ]`,
+    this.charTable = "@farpy.chars";
+    this.module.addGlobal(
+      `${this.charTable} = private unnamed_addr constant [256 x [2 x i8]] [${
+        chars.join(", ")
+      }], align 1`,
     );
-
-    return { value: phiResult, type: "i1" };
+    return this.charTable;
   }
 
-  private generateIdentifier(
-    id: Identifier,
-    entry: LLVMBasicBlock,
-    _main: LLVMFunction,
-  ): IRValue {
-    if (!this.variables.get(id.value)) {
-      throw new Error(`Unknown variable: ${id.value}`);
-    }
+  private declareVectorType(vectorType: string, elementType: string): void {
+    if (this.vectorTypes.has(vectorType)) return;
 
-    const variable = this.variables.get(id.value) as IRValue;
+    this.vectorTypes.set(vectorType, elementType);
+    this.module.addGlobal(
+      `${vectorType} = type { ${elementType}*, i64, i64 }`,
+    );
+  }
 
-    if (this.debug) {
-      entry.add(
-        `; DEBUG - LINE: ${id.loc.line} | RAW: ${id.loc.line_string}`,
-      );
-    }
+  private isVectorValue(value: IRValue): boolean {
+    return value.type.startsWith("%farpy.vec.") && value.type.endsWith("*") &&
+      !value.type.endsWith("**");
+  }
 
-    return entry.loadInst({
-      value: variable.value as string,
-      type: variable.type as string,
-    });
+  private declareRuntimeFunction(name: string, ir: string): void {
+    if (this.declaredFuncs.has(name)) return;
+
+    this.declaredFuncs.add(name);
+    this.module.addExternal(ir);
   }
 
-  private generateVariableDeclaration(
-    decl: VariableDeclaration,
-    entry: LLVMBasicBlock,
-    main: LLVMFunction,
-  ): IRValue {
-    // console.log(
-    //   "Erro!",
-    //   this.instance.lookupSymbol(decl.id.value)!,
-    //   decl.id.value,
-    //   this.instance.lookupSymbol(decl.value.value),
-    //   decl.value.value,
-    // );
-    const type = this.instance.lookupSymbol(decl.id.value)!.llvmType;
-    const value = this.generateNode(decl.value, main);
-    let variable = this.makeIrValue("0", "i32");
+  private constantArrayInitializer(node: ArrayLiteral): string | null {
+    if (node.value.length == 0) return null;
 
-    if (decl.type.isArray) {
-      variable = value;
-    }
+    const elementType = node.llvmType as string;
+    const elements: string[] = [];
 
-    if (decl.type.isStruct) {
-      variable = value;
+    for (const element of node.value) {
+      const constant = this.constantInitializer(element, elementType);
+      if (constant == null) return null;
+      elements.push(`${elementType} ${constant}`);
     }
 
-    if (!decl.type.isArray && !decl.type.isStruct) {
-      variable = entry.allocaInst(type);
-    }
+    return `[${elements.join(", ")}]`;
+  }
 
-    if (this.debug) {
-      entry.add(
-        `; DEBUG - LINE: ${decl.loc.line} | RAW: ${decl.loc.line_string}`,
-      );
-    }
+  // Returns the LLVM constant for a literal initializer, or null when the
+  // value has to be computed at runtime.
+  private constantInitializer(node: Expr, type: string): string | null {
+    let value: number;
 
-    // TODO: Improve this
-    if (value.type == "i8" || value.type == "i8*") {
-      if (decl.value.kind == "StringLiteral") {
-        entry.storeInst(
-          entry.getElementPtr(
-            `[${decl.value.value.length + 1} x i8]`,
-            value.value,
-          ),
-          variable,
-        );
-      } else {
-        entry.storeInst(value, variable);
+    switch (node.kind) {
+      case "IntLiteral":
+      case "FloatLiteral":
+      case "BooleanLiteral":
+        value = Number(node.value);
+        break;
+      case "BinaryLiteral":
+        value = parseInt(String(node.value).replace(/^0b/, ""), 2);
+        break;
+      case "UnaryExpr": {
+        const unary = node as UnaryExpr;
+        if (unary.operator != "-") return null;
+        const operand = this.constantInitializer(unary.operand, type);
+        if (operand == null || type.endsWith("*")) return null;
+        return operand.startsWith("-") ? operand.slice(1) : `-${operand}`;
+      }
+      case "NullLiteral":
+        return type.endsWith("*") || type == "ptr" ? "null" : null;
+      case "StringLiteral": {
+        if (type == FAT_STRING) {
+          return this.fatStringConstant(node as StringLiteral);
+        }
+        if (type != "i8*") return null;
+        const label = createStringGlobal(this.module, node.value);
+        const arrayType = `[${stringByteLength(node.value) + 1} x i8]`;
+        return `getelementptr inbounds (${arrayType}, ${arrayType}* ${label}, i32 0, i32 0)`;
       }
+      default:
+        return null;
     }
 
-    if (!decl.type.isArray && !decl.type.isStruct) {
-      entry.storeInst(
-        { value: value.value, type: type as string },
-        variable,
-      );
+    if (type == "i1") return value != 0 ? "true" : "false";
+    if (/^i\d+$/.test(type)) return String(Math.trunc(value));
+    if (type == "double") {
+      return this.makeIrValue(String(value), "double").value;
     }
-
-    this.variables.set(decl.id.value, variable);
-    return variable;
+    return null;
   }
 
   private generateStringLiteral(
@@ -28,6 +28,7 @@ import {
   IncrementExpr,
   IntLiteral,
   Program,
+  RegionStatement,
   ReturnStatement,
   Stmt,
   StringLiteral,
@@ -35,9 +36,14 @@ import {
   VariableDeclaration,
   WhileStatement,
 } from "../frontend/parser/ast.ts";
+import { Semantic } from "./semantic.ts";
+import { MATH_FOLDS } from "./standard_library.ts";
 
 export class Optimizer {
-  public constructor(private readonly reporter: DiagnosticReporter) {}
+  public constructor(
+    private readonly reporter: DiagnosticReporter,
+    private readonly semantic: Semantic,
+  ) {}
 
   public resume(ast: Program): Program {
     const new_ast = {
@@ -92,6 +98,8 @@ export class Optimizer {
         return this.optimizeForRangeStatement(expr as ForRangeStatement);
       case "WhileStatement":
         return this.optimizeWhileStatement(expr as WhileStatement);
+      case "RegionStatement":
+        return this.optimizeRegionStatement(expr as RegionStatement);
       case "IntLiteral":
       case "FloatLiteral":
       case "StringLiteral":
@@ -127,6 +135,11 @@ export class Optimizer {
     return node;
   }
 
+  private optimizeRegionStatement(node: RegionStatement): RegionStatement {
+    node.block = node.block.map((stmt) => this.optimize(stmt));
+    return node;
+  }
+
   private optimizeForRangeStatement(
     node: ForRangeStatement,
   ): ForRangeStatement {
@@ -164,9 +177,86 @@ export class Optimizer {
       fnDecl.block.push(this.optimize(expr));
     }
 
+    fnDecl.tailRecursive = this.markSelfTailCalls(fnDecl, fnDecl.block, true);
+
     return fnDecl;
   }
 
+  // Marks direct self-calls in tail position so the IR generator can lower
+  // the recursion as a jump back to the top of the function. `atEnd` tells
+  // whether falling off `body` also falls off the function.
+  private markSelfTailCalls(
+    fnDecl: FunctionDeclaration,
+    body: Stmt[],
+    atEnd: boolean,
+  ): boolean {
+    let found = false;
+
+    for (let i = 0; i < body.length; i++) {
+      const stmt = body[i];
+      const isLast = atEnd && i == body.length - 1;
+
+      switch (stmt.kind) {
+        case "ReturnStatement": {
+          const expr = (stmt as ReturnStatement).expr;
+          if (this.isSelfCall(fnDecl, expr)) {
+            (expr as CallExpr).tailCall = true;
+            found = true;
+          }
+          break;
+        }
+        case "CallExpr":
+          // A bare call is only in tail position in a void function
+          if (
+            isLast && fnDecl.type.baseType == "void" &&
+            this.isSelfCall(fnDecl, stmt)
+          ) {
+            (stmt as CallExpr).tailCall = true;
+            found = true;
+          }
+          break;
+        case "IfStatement":
+        case "ElifStatement": {
+          const node = stmt as IfStatement;
+          found = this.markSelfTailCalls(fnDecl, node.primary, isLast) ||
+            found;
+          if (node.secondary !== null) {
+            found = this.markSelfTailCalls(fnDecl, [node.secondary], isLast) ||
+              found;
+          }
+          break;
+        }
+        case "ElseStatement":
+          found = this.markSelfTailCalls(
+            fnDecl,
+            (stmt as ElseStatement).primary,
+            isLast,
+          ) || found;
+          break;
+        // A return inside a region still has to release it, so the call
+        // before it is never in tail position
+        case "RegionStatement":
+        case "ForRangeStatement":
+        case "WhileStatement":
+          found = this.markSelfTailCalls(
+            fnDecl,
+            (stmt as ForRangeStatement | RegionStatement | WhileStatement)
+              .block,
+            false,
+          ) || found;
+          break;
+      }
+    }
+
+    return found;
+  }
+
+  private isSelfCall(fnDecl: FunctionDeclaration, expr: Expr | Stmt): boolean {
+    return expr.kind == "CallExpr" &&
+      (expr as CallExpr).callee.value == fnDecl.id.value &&
+      (expr as CallExpr).arguments.length == fnDecl.args.length;
+  }
+
   private optimizeElseStmt(node: ElseStatement): ElseStatement {
     const body = node.primary;
     node.primary = [];
@@ -203,11 +293,35 @@ export class Optimizer {
     return varDecl;
   }
 
-  private optimizeCallExpr(callExpr: CallExpr): CallExpr {
+  private optimizeCallExpr(callExpr: CallExpr): Expr {
     callExpr.arguments = callExpr.arguments.map((arg: Expr | Stmt) =>
       this.optimize(arg)
     );
-    return callExpr;
+    return this.foldMathCall(callExpr) ?? callExpr;
+  }
+
+  // `sqrt(2.0)`, `pi()`, ... from the math module become float literals
+  private foldMathCall(callExpr: CallExpr): Expr | null {
+    const fold = MATH_FOLDS.get(callExpr.callee.value);
+    const funcInfo = this.semantic.availableFunctions.get(
+      callExpr.callee.value,
+    );
+
+    if (
+      !fold || !funcInfo || !("isStdLib" in funcInfo) || !funcInfo.isStdLib ||
+      !callExpr.arguments.every((arg) => this.isNumericLiteral(arg))
+    ) {
+      return null;
+    }
+
+    const result = fold(
+      ...callExpr.arguments.map((arg) => this.getLiteralValue(arg)),
+    );
+
+    // NaN, infinities and exponent notation have no float literal form
+    if (!/^-?\d+(\.\d+)?$/.test(String(result))) return null;
+
+    return AST_FLOAT(result, callExpr.loc);
   }
 
   private optimizeUnaryExpr(
@@ -16,6 +16,8 @@ import {
   CallExpr,
   CastExpr,
   createArrayType,
+  createPointerType,
+  createSliceType,
   createTypeInfo,
   ElifStatement,
   ElseStatement,
@@ -27,6 +29,7 @@ import {
   ImportStatement,
   IndexAccess,
   LLVMType,
+  RegionStatement,
   ReturnStatement,
   StructExpr,
   StructPAssignment,
@@ -47,14 +50,31 @@ import {
   VariableDeclaration,
 } from "../frontend/parser/ast.ts";
 import { Parser } from "../frontend/parser/parser.ts";
-import { TypesNative } from "../frontend/values.ts";
-import { StandardLibrary } from "./standard_library.ts";
+import { AtomicTypes, SimdTypes, TypesNative } from "../frontend/values.ts";
+import {
+  ATOMIC_FUNCTIONS,
+  ATOMIC_ORDERINGS,
+  SIMD_FUNCTIONS,
+  SLICE_FUNCTIONS,
+  StandardLibrary,
+  TYPED_FUNCTIONS,
+  VECTOR_FUNCTIONS,
+} from "./standard_library.ts";
 import {
   Function,
   StdLibFunction,
   StdLibModule,
 } from "./std_lib_module_builder.ts";
 import { getTypeChecker, TypeChecker } from "./type_checker.ts";
+import { AtomicOrdering } from "../ts-ir/types/IRTypes.ts";
+
+// vec_* calls that change the vector they are given
+const VECTOR_MUTATORS = new Set([
+  "vec_push",
+  "vec_reserve",
+  "vec_clear",
+  "vec_free",
+]);
 
 export interface TypeMapping {
   sourceType: TypesNative | TypesNative[];
@@ -80,6 +100,12 @@ export class Semantic {
   public structs: Map<string, StructStatement> = new Map();
   public identifiersUsed: Set<string> = new Set();
   private externalNodes: Stmt[] = [];
+  // Names visible where the innermost `pfor` starts; its body may read them
+  // but only write the ones listed in a reduce clause.
+  private parallelOuter: Set<string> | null = null;
+  private parallelReductions: Set<string> = new Set();
+  // Open `region` blocks around the statement being analyzed
+  private regionDepth = 0;
 
   private constructor(private readonly reporter: DiagnosticReporter) {
     this.pushScope();
@@ -184,6 +210,9 @@ export class Semantic {
       case "WhileStatement":
         analyzedNode = this.analyzeWhileStatement(node as WhileStatement);
         break;
+      case "RegionStatement":
+        analyzedNode = this.analyzeRegionStatement(node as RegionStatement);
+        break;
       case "FunctionDeclaration":
         analyzedNode = this.analyzeFnDeclaration(node as FunctionDeclaration);
         break;
@@ -250,6 +279,31 @@ export class Semantic {
   }
 
   private analyzeIndexAccess(node: IndexAccess): IndexAccess {
+    const vector = this.lookupSymbol(node.target.value);
+
+    if (vector?.sourceType.isVector) {
+      node.type = createTypeInfo(vector.sourceType.baseType);
+      node.llvmType = vector.llvmType;
+      node.index = this.analyzeNode(node.index);
+      return node;
+    }
+
+    if (vector?.sourceType.isSlice) {
+      node.type = createTypeInfo(vector.sourceType.baseType);
+      node.llvmType = this.typeChecker.mapToLLVMType(node.type.baseType);
+      node.index = this.analyzeNode(node.index);
+      return node;
+    }
+
+    if (vector && this.isSimdSymbol(vector.sourceType)) {
+      const simdType = vector.sourceType.baseType;
+      node.type = createTypeInfo(this.typeChecker.simdLaneType(simdType));
+      node.llvmType = this.typeChecker.mapToLLVMType(node.type.baseType);
+      node.index = this.analyzeNode(node.index);
+      this.checkSimdLane(node.index, simdType);
+      return node;
+    }
+
     const target = this.scopeStack[0].get(node.target.value);
 
     if (
@@ -352,6 +406,7 @@ export class Semantic {
     }
 
     stack = stack as SymbolInfo;
+    this.checkParallelWrite(node.from as Identifier);
 
     if (!stack.sourceType.isStruct) {
       this.reporter.addError(
@@ -578,31 +633,11 @@ export class Semantic {
         );
       }
 
-      let dereferenceCount = 1;
-      let currentExpr: Expr = node.operand;
-
-      while (
-        currentExpr.kind === "UnaryExpr" &&
-        (currentExpr as UnaryExpr).operator === "*"
-      ) {
-        dereferenceCount++;
-        currentExpr = (currentExpr as UnaryExpr).operand;
-      }
-
+      // The operand is analyzed first, so `**p` already lost one level
       const pointerLevel = node.operand.type.pointerLevel || 0;
 
-      if (dereferenceCount > pointerLevel) {
-        this.reporter.addError(
-          node.loc,
-          `Cannot dereference pointer of level ${pointerLevel} with ${dereferenceCount} dereference operations`,
-        );
-        throw new Error(
-          `Cannot dereference pointer of level ${pointerLevel} with ${dereferenceCount} dereference operations at ${node.loc.line}:${node.loc.start}`,
-        );
-      }
-
       const newType = { ...node.operand.type };
-      newType.pointerLevel = Math.max(0, pointerLevel);
+      newType.pointerLevel = Math.max(0, pointerLevel - 1);
       newType.isPointer = newType.pointerLevel > 0;
 
       node.llvmType = newType.pointerLevel === 0
@@ -641,6 +676,28 @@ export class Semantic {
     return node;
   }
 
+  private analyzeRegionStatement(node: RegionStatement): RegionStatement {
+    if (!this.importedModules.has("arena")) {
+      this.reporter.addError(
+        node.loc,
+        "'region' requires the 'arena' module",
+        [this.reporter.makeSuggestion('Add `import "arena"` to this file.')],
+      );
+      throw new Error("'region' requires the 'arena' module");
+    }
+
+    this.regionDepth++;
+    try {
+      for (let i = 0; i < node.block.length; i++) {
+        node.block[i] = this.analyzeNode(node.block[i]);
+      }
+    } finally {
+      this.regionDepth--;
+    }
+
+    return node;
+  }
+
   private analyzeExternStatement(node: ExternStatement): ExternStatement {
     for (const func of node.functions) {
       const funcName = func.name;
@@ -683,13 +740,17 @@ export class Semantic {
     node.from = this.analyzeNode(node.from);
     node.to = this.analyzeNode(node.to);
 
+    if (node.parallel) {
+      return this.analyzeParallelForStmt(node);
+    }
+
     if (node.id) {
       this.defineSymbol({
         id: node.id.value,
         sourceType: createTypeInfo("int"),
         llvmType: LLVMType.I32,
-        mutable: true,
-        initialized: false,
+        mutable: false,
+        initialized: true,
         loc: node.id.loc,
       });
     }
@@ -705,6 +766,104 @@ export class Semantic {
     return node;
   }
 
+  private analyzeParallelForStmt(node: ForRangeStatement): ForRangeStatement {
+    if (!this.importedModules.has("parallel")) {
+      this.reporter.addError(
+        node.loc,
+        "'pfor' requires the 'parallel' module",
+        [this.reporter.makeSuggestion('Add `import "parallel"` to this file.')],
+      );
+      throw new Error("'pfor' requires the 'parallel' module");
+    }
+
+    const reductions = new Set<string>();
+    for (const reduction of node.reductions ?? []) {
+      const name = reduction.id.value;
+      const symbol = this.lookupSymbol(name);
+
+      if (!symbol) {
+        this.reporter.addError(
+          reduction.id.loc,
+          `Variable '${name}' is not defined`,
+        );
+        throw new Error(`Variable '${name}' is not defined`);
+      }
+
+      const type = symbol.sourceType;
+      if (
+        !["int", "i64", "float", "double"].includes(type.baseType) ||
+        type.isArray || type.isPointer || type.isVector || type.isSlice
+      ) {
+        this.reporter.addError(
+          reduction.id.loc,
+          `Reduction variable '${name}' must be an int, i64, float or double`,
+        );
+        throw new Error(
+          `Reduction variable '${name}' must be an int, i64, float or double`,
+        );
+      }
+
+      if (!symbol.mutable) {
+        this.reporter.addError(
+          reduction.id.loc,
+          `Cannot reduce into immutable variable '${name}'`,
+        );
+        throw new Error(`Cannot reduce into immutable variable '${name}'`);
+      }
+
+      if (reductions.has(name) || name == node.id?.value) {
+        this.reporter.addError(
+          reduction.id.loc,
+          `'${name}' cannot be used as a reduction variable here`,
+        );
+        throw new Error(
+          `'${name}' cannot be used as a reduction variable here`,
+        );
+      }
+
+      reduction.id.type = type;
+      reduction.id.llvmType = symbol.llvmType;
+      reductions.add(name);
+      this.identifiersUsed.add(name);
+    }
+
+    const outer = new Set<string>();
+    for (const scope of this.scopeStack) {
+      for (const name of scope.keys()) outer.add(name);
+    }
+
+    const savedOuter = this.parallelOuter;
+    const savedReductions = this.parallelReductions;
+    this.parallelOuter = outer;
+    this.parallelReductions = reductions;
+
+    // The body becomes its own function: the counter and its locals end
+    // with the loop
+    this.pushScope();
+
+    if (node.id) {
+      this.defineSymbol({
+        id: node.id.value,
+        sourceType: createTypeInfo("int"),
+        llvmType: LLVMType.I32,
+        mutable: false,
+        initialized: true,
+        loc: node.id.loc,
+      });
+    }
+
+    for (let i = 0; i < node.block.length; i++) {
+      node.block[i] = this.analyzeNode(node.block[i]);
+    }
+
+    node.scope = this.currentScope();
+    this.popScope();
+    this.parallelOuter = savedOuter;
+    this.parallelReductions = savedReductions;
+
+    return node;
+  }
+
   private analyzeElseStatement(
     node: ElseStatement,
   ): ElseStatement {
@@ -758,7 +917,21 @@ export class Semantic {
       );
     }
 
-    if (symbol.llvmType != analyzedValue.llvmType) {
+    if (this.isAtomicSymbol(symbol.sourceType)) {
+      this.reporter.addError(
+        node.id.loc,
+        `'${node.id.value}' is atomic; assign it with atomic_store`,
+      );
+      throw new Error(
+        `'${node.id.value}' is atomic; assign it with atomic_store`,
+      );
+    }
+
+    // A str variable also takes plain strings, converted when stored
+    const toFatString = this.isFatStringSymbol(symbol.sourceType) &&
+      this.isFatStringSource(analyzedValue.type);
+
+    if (symbol.llvmType != analyzedValue.llvmType && !toFatString) {
       this.reporter.addError(
         node.loc,
         `The variable was initially ${symbol.sourceType.baseType}, but you passed a value of type ${analyzedValue.type.baseType}.`,
@@ -778,6 +951,8 @@ export class Semantic {
       );
     }
 
+    this.checkParallelWrite(node.id);
+
     this.identifiersUsed.add(node.id.value);
 
     return {
@@ -816,34 +991,49 @@ export class Semantic {
         arg.type.isStruct = true;
       }
 
-      const llvmType = this.typeChecker.mapToLLVMType(arg.type.baseType);
-      arg.llvmType = llvmType;
+      if (this.isFatStringSymbol(arg.type)) {
+        this.requireStringModule(arg.type, arg.id.loc);
+      }
+
+      const llvmType = arg.type.isSlice
+        ? this.typeChecker.mapToLLVMSliceType(arg.type.baseType)
+        : this.typeChecker.mapToLLVMType(arg.type.baseType);
+      // Vectors are passed by reference
+      arg.llvmType = arg.type.isVector
+        ? this.vectorParamType(arg.type, arg.id.loc)
+        : llvmType;
 
       this.defineSymbol({
         id: arg.id.value,
         sourceType: arg.type,
         llvmType: llvmType,
-        mutable: true,
+        // A vector parameter is the caller's vector, which it may not grow
+        mutable: !arg.type.isVector,
         initialized: true,
         loc: arg.id.loc,
       });
 
       analyzedArgs.push({
         ...arg,
-        llvmType: llvmType,
+        llvmType: arg.llvmType,
       });
     }
 
     const returnType = node.type || createTypeInfo("void");
+    if (this.isFatStringSymbol(returnType)) {
+      this.requireStringModule(returnType, node.loc);
+    }
 
-    const returnLLVMType = this.typeChecker.mapToLLVMType(returnType.baseType);
+    const returnLLVMType = returnType.isSlice
+      ? this.typeChecker.mapToLLVMSliceType(returnType.baseType)
+      : this.typeChecker.mapToLLVMType(returnType.baseType);
 
     const funcInfo = {
       name: funcName,
-      params: node.args.map((arg) => ({
+      params: analyzedArgs.map((arg) => ({
         name: arg.id.value,
         type: arg.type,
-        llvmType: this.typeChecker.mapToLLVMType(arg.type.baseType),
+        llvmType: arg.llvmType,
       })),
       returnType: returnType,
       llvmType: returnLLVMType,
@@ -909,11 +1099,46 @@ export class Semantic {
   }
 
   private analyzeReturnStatement(node: ReturnStatement): ReturnStatement {
+    if (this.parallelOuter) {
+      this.reporter.addError(
+        node.loc,
+        "'return' is not allowed inside a pfor body",
+      );
+      throw new Error("'return' is not allowed inside a pfor body");
+    }
+
     node.expr = this.analyzeNode(node.expr);
     node.llvmType = node.expr.llvmType;
+
+    // The region is rewound before the function returns, taking any
+    // string or view built inside it along
+    if (this.regionDepth > 0 && this.pointsIntoMemory(node.llvmType)) {
+      this.reporter.addError(
+        node.loc,
+        "Cannot return a string, pointer or view from inside a 'region'",
+        [
+          this.reporter.makeSuggestion(
+            "Return it after the region ends, or copy it with malloc.",
+          ),
+        ],
+      );
+      throw new Error(
+        "Cannot return a string, pointer or view from inside a 'region'",
+      );
+    }
+
     return node;
   }
 
+  private pointsIntoMemory(llvmType: string | undefined): boolean {
+    return !!llvmType && (
+      llvmType.endsWith("*") ||
+      llvmType == LLVMType.PTR ||
+      llvmType.startsWith("%farpy.slice.") ||
+      llvmType == "%farpy.str"
+    );
+  }
+
   private analyzeImportStatement(node: ImportStatement): ImportStatement {
     if (!node.isStdLib) {
       return this.analyzeImportExternal(node);
@@ -1060,6 +1285,26 @@ export class Semantic {
       this.identifiersUsed.add(funcInfo.name);
     }
 
+    if (VECTOR_FUNCTIONS.has(funcName) && "isStdLib" in funcInfo) {
+      return this.analyzeVectorCall(node);
+    }
+
+    if (SLICE_FUNCTIONS.has(funcName) && "isStdLib" in funcInfo) {
+      return this.analyzeSliceCall(node);
+    }
+
+    if (SIMD_FUNCTIONS.has(funcName) && "isStdLib" in funcInfo) {
+      return this.analyzeSimdCall(node);
+    }
+
+    if (ATOMIC_FUNCTIONS.has(funcName) && "isStdLib" in funcInfo) {
+      return this.analyzeAtomicCall(node);
+    }
+
+    if (TYPED_FUNCTIONS.has(funcName) && "isStdLib" in funcInfo) {
+      return this.analyzeTypedCall(node);
+    }
+
     for (let i = 0; i < node.arguments.length; i++) {
       node.arguments[i] = this.analyzeNode(node.arguments[i]);
 
@@ -1067,6 +1312,9 @@ export class Semantic {
       const param = funcInfo.params[i];
 
       if (param === undefined && funcInfo.isVariadic) {
+        if (argType.isSlice || this.isFatStringSymbol(argType)) {
+          this.rejectViewArgument(node, i, "...");
+        }
         continue;
       }
 
@@ -1074,6 +1322,88 @@ export class Semantic {
         ? param as TypesNative
         : param.type.baseType as TypesNative;
 
+      // String views also accept plain and fat strings
+      if (param === "view") {
+        if (
+          (argType.baseType !== "string" && !this.isFatStringSymbol(argType)) ||
+          argType.isArray || argType.isVector
+        ) {
+          this.reporter.addError(
+            node.arguments[i].loc,
+            `Argument ${
+              i + 1
+            } of function '${funcName}' expects type 'string[:]', but got '${
+              typeInfoToString(argType)
+            }'`,
+          );
+          throw new Error(
+            `Argument ${
+              i + 1
+            } of function '${funcName}' expects type 'string[:]', but got '${
+              typeInfoToString(argType)
+            }'`,
+          );
+        }
+        continue;
+      }
+
+      const paramIsSlice = typeof param !== "string" &&
+        Boolean(param.type.isSlice);
+      if (
+        (argType.isSlice || paramIsSlice) &&
+        (!argType.isSlice || !paramIsSlice ||
+          (param as { type: TypeInfo }).type.baseType !== argType.baseType)
+      ) {
+        this.rejectViewArgument(
+          node,
+          i,
+          typeof param === "string" ? param : typeInfoToString(param.type),
+        );
+      }
+
+      // Vectors are passed by reference, so the element type must match
+      if (
+        typeof param !== "string" &&
+        (param.type.isVector || argType.isVector) &&
+        (!param.type.isVector || !argType.isVector ||
+          param.type.baseType !== argType.baseType)
+      ) {
+        this.reporter.addError(
+          node.arguments[i].loc,
+          `Argument ${
+            i + 1
+          } of function '${funcName}' expects type '${
+            typeInfoToString(param.type)
+          }', but got '${typeInfoToString(argType)}'`,
+        );
+        throw new Error(
+          `Argument ${
+            i + 1
+          } of function '${funcName}' expects type '${
+            typeInfoToString(param.type)
+          }', but got '${typeInfoToString(argType)}'`,
+        );
+      }
+
+      // Untyped pointer parameters (free, arena_*, pool_*) take any pointer
+      if (
+        paramType === "null" &&
+        (argType.isPointer ||
+          ["null", "string"].includes(String(argType.baseType)))
+      ) {
+        continue;
+      }
+
+      // Plain strings are converted to `str` when the call is generated
+      if (paramType === "str" && this.isFatStringSource(argType)) {
+        node.arguments[i].llvmType = this.typeChecker.mapToLLVMType("str");
+        continue;
+      }
+
+      if (this.isFatStringSymbol(argType) && paramType === "string") {
+        this.rejectViewArgument(node, i, "string");
+      }
+
       if (argType.baseType !== "string" && paramType === "string") {
         node.arguments[i].type.baseType = "string";
         node.arguments[i].value = String(node.arguments[i].value);
@@ -1152,6 +1482,25 @@ export class Semantic {
   private analyzeVariableDeclaration(
     decl: VariableDeclaration,
   ): VariableDeclaration {
+    if (decl.type.isVector) {
+      return this.analyzeVectorDeclaration(decl);
+    }
+
+    if (this.isSimdSymbol(decl.type)) {
+      return this.analyzeSimdDeclaration(decl);
+    }
+
+    if (this.isAtomicSymbol(decl.type)) {
+      return this.analyzeAtomicDeclaration(decl);
+    }
+
+    if (this.isFatStringSymbol(decl.type)) {
+      return this.analyzeFatStringDeclaration(decl);
+    }
+
+    // Without an annotation the parser hands the value's own TypeInfo to
+    // the declaration
+    const annotated = decl.type !== decl.value.type;
     const analyzedValue = this.analyzeNode(decl.value) as Expr;
 
     if (this.currentScope().has(decl.id.value)) {
@@ -1164,11 +1513,15 @@ export class Semantic {
       );
     }
 
-    const actualType = analyzedValue.type;
+    // A numeric annotation sets the width: `new n: i64 = 1` is an i64
+    const actualType = annotated && this.isNumericScalar(decl.type) &&
+        this.isNumericScalar(analyzedValue.type)
+      ? decl.type
+      : analyzedValue.type;
 
     // Check pointer type compatibility
     if (
-      this.typeChecker.isPointerType(actualType) &&
+      annotated && this.typeChecker.isPointerType(actualType) &&
       !this.typeChecker.isPointerType(decl.type)
     ) {
       this.reporter.addError(
@@ -1207,8 +1560,15 @@ export class Semantic {
       }
     }
 
-    const llvmType = this.typeChecker.mapToLLVMType(actualType.baseType);
+    const llvmType = actualType.isSlice
+      ? this.typeChecker.mapToLLVMSliceType(actualType.baseType)
+      : actualType.isPointer
+      ? LLVMType.PTR
+      : this.typeChecker.mapToLLVMType(actualType.baseType);
     decl.type.baseType = actualType.baseType;
+    decl.type.isSlice = actualType.isSlice;
+    decl.type.isPointer = actualType.isPointer;
+    decl.type.pointerLevel = actualType.pointerLevel;
 
     this.defineSymbol({
       id: decl.id.value,
@@ -1227,79 +1587,992 @@ export class Semantic {
     };
   }
 
-  private analyzeIncrementExpr(expr: IncrementExpr): IncrementExpr {
-    const analyzedValue = this.analyzeNode(expr.value) as Expr;
+  private isNumericScalar(type: TypeInfo): boolean {
+    return this.typeChecker.isNumericType(type.baseType) && !type.isArray &&
+      !type.isPointer && !type.isSlice && !type.isVector;
+  }
 
-    if (analyzedValue.kind !== "Identifier") {
-      this.reporter.addError(
-        expr.loc,
-        "Cannot increment non-variable expression",
-      );
-      throw new Error(
-        `Cannot increment non-variable expression at ${expr.loc.line}:${expr.loc.start}`,
-      );
-    }
+  // `new mut v: T[..] = [...]` - the literal only seeds the vector, so an
+  // empty `[]` is fine and every element has to fit T.
+  private analyzeVectorDeclaration(
+    decl: VariableDeclaration,
+  ): VariableDeclaration {
+    this.requireVectorModule(decl.type, decl.loc);
 
-    if (
-      analyzedValue.type.baseType !== "int" &&
-      analyzedValue.type.baseType !== "float"
-    ) {
+    if (decl.value.kind !== "ArrayLiteral") {
       this.reporter.addError(
-        expr.loc,
-        `Cannot increment variable of type '${analyzedValue.type}'`,
+        decl.value.loc,
+        `Vector '${decl.id.value}' must be initialized with an array literal`,
       );
       throw new Error(
-        `Cannot increment variable of type '${analyzedValue.type}' at ${expr.loc.line}:${expr.loc.start}`,
+        `Vector '${decl.id.value}' must be initialized with an array literal`,
       );
     }
 
-    const symbol = this.lookupSymbol((analyzedValue as Identifier).value);
-    if (symbol && !symbol.mutable) {
+    if (this.currentScope().has(decl.id.value)) {
       this.reporter.addError(
-        expr.loc,
-        `Cannot increment immutable variable '${
-          (analyzedValue as Identifier).value
-        }'`,
+        decl.id.loc,
+        `Variable '${decl.id.value}' is already defined in this scope`,
       );
       throw new Error(
-        `Cannot increment immutable variable '${
-          (analyzedValue as Identifier).value
-        }' at ${expr.loc.line}:${expr.loc.start}`,
+        `Variable '${decl.id.value}' is already defined in this scope at ${decl.loc.line}:${decl.loc.start}`,
       );
     }
 
+    const elementType = decl.type.baseType;
+    const llvmType = this.typeChecker.mapToLLVMType(elementType);
+    const literal = decl.value as ArrayLiteral;
+    const elements = literal.value.map((element) =>
+      this.analyzeVectorElement(element, elementType)
+    );
+
+    this.defineSymbol({
+      id: decl.id.value,
+      sourceType: decl.type,
+      llvmType: llvmType,
+      mutable: decl.mutable,
+      initialized: true,
+      loc: decl.loc,
+    });
+
     return {
-      ...expr,
-      value: analyzedValue,
-      type: analyzedValue.type,
-      llvmType: (analyzedValue as Expr).llvmType,
+      ...decl,
+      value: {
+        ...literal,
+        value: elements,
+        type: decl.type,
+        llvmType: llvmType,
+      } as ArrayLiteral,
+      llvmType: this.typeChecker.mapToLLVMVectorType(elementType),
     };
   }
 
-  private analyzeDecrementExpr(expr: DecrementExpr): DecrementExpr {
-    const analyzedValue = this.analyzeNode(expr.value) as Expr;
+  // vec_* calls take the vector itself as the first argument; the
+  // remaining ones are checked against its element type.
+  private analyzeVectorCall(node: CallExpr): CallExpr {
+    const funcName = node.callee.value;
+    const target = node.arguments[0] as Expr;
+    const vector = target.kind === "Identifier"
+      ? this.lookupSymbol(target.value)
+      : undefined;
 
-    if (analyzedValue.kind !== "Identifier") {
+    if (!vector?.sourceType.isVector) {
       this.reporter.addError(
-        expr.loc,
-        "Cannot decrement non-variable expression",
+        target.loc,
+        `Function '${funcName}' expects a vector as its first argument`,
       );
       throw new Error(
-        `Cannot decrement non-variable expression at ${expr.loc.line}:${expr.loc.start}`,
+        `Function '${funcName}' expects a vector as its first argument`,
       );
     }
 
-    if (
-      analyzedValue.type.baseType !== "int" &&
-      analyzedValue.type.baseType !== "float"
-    ) {
-      this.reporter.addError(
-        expr.loc,
-        `Cannot decrement variable of type '${analyzedValue.type}'`,
-      );
-      throw new Error(
-        `Cannot decrement variable of type '${analyzedValue.type}' at ${expr.loc.line}:${expr.loc.start}`,
-      );
+    node.arguments[0] = this.analyzeNode(target);
+
+    if (VECTOR_MUTATORS.has(funcName)) {
+      // vec_free releases the buffer and leaves the variable as it is
+      if (funcName !== "vec_free" && !vector.mutable) {
+        this.reporter.addError(
+          target.loc,
+          `Cannot assign to immutable variable '${target.value}'`,
+        );
+        throw new Error(
+          `Cannot assign to immutable variable '${target.value}' at ${target.loc.line}:${target.loc.start}`,
+        );
+      }
+      this.checkParallelWrite(target as Identifier);
+    }
+
+    if (funcName === "vec_push") {
+      node.arguments[1] = this.analyzeVectorElement(
+        node.arguments[1] as Expr,
+        vector.sourceType.baseType,
+      );
+    }
+
+    if (funcName === "vec_reserve") {
+      const count = this.analyzeNode(node.arguments[1]) as Expr;
+      if (!this.typeChecker.isNumericType(count.type.baseType)) {
+        this.reporter.addError(
+          count.loc,
+          `Function 'vec_reserve' expects a numeric capacity, but got '${count.type.baseType}'`,
+        );
+        throw new Error(
+          `Function 'vec_reserve' expects a numeric capacity, but got '${count.type.baseType}'`,
+        );
+      }
+      node.arguments[1] = count;
+    }
+
+    return node;
+  }
+
+  // slice(x, start, end) borrows [start, end) of a string, 1-D array,
+  // vector or another view without copying.
+  private analyzeSliceCall(node: CallExpr): CallExpr {
+    const funcName = node.callee.value;
+    node.arguments = node.arguments.map((arg) => this.analyzeNode(arg));
+
+    const source = node.arguments[0] as Expr;
+    const type = source.type;
+
+    if (funcName === "slice_len") {
+      if (!type.isSlice) {
+        this.reporter.addError(
+          source.loc,
+          `Function 'slice_len' expects a view, but got '${
+            typeInfoToString(type)
+          }'`,
+        );
+        throw new Error(
+          `Function 'slice_len' expects a view, but got '${
+            typeInfoToString(type)
+          }'`,
+        );
+      }
+      return node;
+    }
+
+    const sliceable = type.isSlice || type.isVector ||
+      (type.isArray && type.dimensions == 1) ||
+      (type.baseType === "string" && !type.isArray && !type.isPointer);
+
+    if (!sliceable) {
+      this.reporter.addError(
+        source.loc,
+        `Cannot slice a value of type '${typeInfoToString(type)}'`,
+      );
+      throw new Error(
+        `Cannot slice a value of type '${typeInfoToString(type)}'`,
+      );
+    }
+
+    for (const bound of node.arguments.slice(1) as Expr[]) {
+      if (!this.typeChecker.isNumericType(bound.type.baseType)) {
+        this.reporter.addError(
+          bound.loc,
+          `Slice bounds must be numeric, but got '${bound.type.baseType}'`,
+        );
+        throw new Error(
+          `Slice bounds must be numeric, but got '${bound.type.baseType}'`,
+        );
+      }
+    }
+
+    node.type = createSliceType(type.baseType);
+    node.llvmType = this.typeChecker.mapToLLVMSliceType(type.baseType);
+    return node;
+  }
+
+  private rejectViewArgument(
+    node: CallExpr,
+    index: number,
+    expected: string,
+  ): never {
+    const argType = typeInfoToString(node.arguments[index].type);
+    const message = `Argument ${
+      index + 1
+    } of function '${node.callee.value}' expects type '${expected}', but got '${argType}'`;
+
+    this.reporter.addError(
+      node.arguments[index].loc,
+      message,
+      node.arguments[index].type.isSlice
+        ? [
+          this.reporter.makeSuggestion(
+            "Use view_to_string() to get a NUL-terminated copy.",
+          ),
+        ]
+        : this.isFatStringSymbol(node.arguments[index].type)
+        ? [
+          this.reporter.makeSuggestion(
+            "Use .cstr() to pass it as a NUL-terminated string.",
+          ),
+        ]
+        : [],
+    );
+    throw new Error(message);
+  }
+
+  private analyzeVectorElement(
+    element: Expr,
+    elementType: TypesNative | string,
+  ): Expr {
+    const analyzed = this.analyzeNode(element) as Expr;
+
+    if (
+      !this.typeChecker.areTypesCompatible(
+        analyzed.type.baseType,
+        elementType,
+      )
+    ) {
+      this.reporter.addError(
+        analyzed.loc,
+        `Vector of '${elementType}' cannot hold a value of type '${
+          typeInfoToString(analyzed.type)
+        }'`,
+      );
+      throw new Error(
+        `Vector of '${elementType}' cannot hold a value of type '${
+          typeInfoToString(analyzed.type)
+        }'`,
+      );
+    }
+
+    return analyzed;
+  }
+
+  private vectorParamType(type: TypeInfo, loc: Loc): string {
+    this.requireVectorModule(type, loc);
+    return `${this.typeChecker.mapToLLVMVectorType(type.baseType)}*`;
+  }
+
+  private requireVectorModule(type: TypeInfo, loc: Loc): void {
+    if (this.importedModules.has("vec")) return;
+
+    this.reporter.addError(
+      loc,
+      `Vector type '${typeInfoToString(type)}' requires the 'vec' module`,
+      [this.reporter.makeSuggestion('Add `import "vec"` to this file.')],
+    );
+    throw new Error(
+      `Vector type '${typeInfoToString(type)}' requires the 'vec' module`,
+    );
+  }
+
+  // `new v: f32x4 = [1.0, 2.0, 3.0, 4.0]` sets every lane; any other
+  // numeric initializer is broadcast to all of them.
+  private analyzeSimdDeclaration(
+    decl: VariableDeclaration,
+  ): VariableDeclaration {
+    this.requireSimdModule(decl.type, decl.loc);
+
+    if (this.currentScope().has(decl.id.value)) {
+      this.reporter.addError(
+        decl.id.loc,
+        `Variable '${decl.id.value}' is already defined in this scope`,
+      );
+      throw new Error(
+        `Variable '${decl.id.value}' is already defined in this scope at ${decl.loc.line}:${decl.loc.start}`,
+      );
+    }
+
+    const simdType = decl.type.baseType;
+    const llvmType = this.typeChecker.mapToLLVMType(simdType);
+    let value: Expr;
+
+    if (decl.value.kind === "ArrayLiteral") {
+      const literal = decl.value as ArrayLiteral;
+      const lanes = SimdTypes[simdType].lanes;
+
+      if (literal.value.length !== lanes) {
+        this.reporter.addError(
+          literal.loc,
+          `Type '${simdType}' has ${lanes} lanes, but the initializer has ${literal.value.length} elements`,
+        );
+        throw new Error(
+          `Type '${simdType}' has ${lanes} lanes, but the initializer has ${literal.value.length} elements`,
+        );
+      }
+
+      value = {
+        ...literal,
+        value: literal.value.map((element) =>
+          this.checkSimdScalar(this.analyzeNode(element) as Expr, simdType)
+        ),
+        type: decl.type,
+        llvmType: llvmType,
+      } as ArrayLiteral;
+    } else {
+      const analyzed = this.analyzeNode(decl.value) as Expr;
+      value = analyzed.type.baseType === simdType
+        ? analyzed
+        : this.checkSimdScalar(analyzed, simdType);
+    }
+
+    this.defineSymbol({
+      id: decl.id.value,
+      sourceType: decl.type,
+      llvmType: llvmType,
+      mutable: decl.mutable,
+      initialized: true,
+      loc: decl.loc,
+    });
+
+    return {
+      ...decl,
+      value: value,
+      llvmType: llvmType,
+    };
+  }
+
+  // alloc<T>(n) returns a *T and pool_new<T>() a pool of T. The type has
+  // to map to an LLVM type here, since the IR generator folds its size
+  // into the call.
+  private analyzeTypedCall(node: CallExpr): CallExpr {
+    const funcName = node.callee.value;
+    const element = node.typeArgument;
+
+    if (!element) {
+      this.reporter.addError(
+        node.loc,
+        `'${funcName}' needs the type to allocate, as in '${funcName}<int>(...)'`,
+      );
+      throw new Error(
+        `'${funcName}' needs the type to allocate, as in '${funcName}<int>(...)'`,
+      );
+    }
+
+    const elementName = typeInfoToString(element);
+    const sized = !element.isArray && !element.isVector && !element.isSlice &&
+      (element.isPointer || this.typeChecker.isSizedType(element.baseType));
+
+    if (!sized) {
+      this.reporter.addError(
+        node.loc,
+        `Cannot allocate values of type '${elementName}' with '${funcName}'`,
+      );
+      throw new Error(
+        `Cannot allocate values of type '${elementName}' with '${funcName}'`,
+      );
+    }
+
+    if (funcName == "pool_new") return node;
+
+    const count = this.analyzeNode(node.arguments[0]) as Expr;
+    if (
+      count.type.isPointer || count.type.isArray ||
+      !["int", "i64", "binary"].includes(String(count.type.baseType))
+    ) {
+      this.reporter.addError(
+        count.loc,
+        `'${funcName}' expects an integer count, but got '${
+          typeInfoToString(count.type)
+        }'`,
+      );
+      throw new Error(
+        `'${funcName}' expects an integer count, but got '${
+          typeInfoToString(count.type)
+        }'`,
+      );
+    }
+
+    node.arguments[0] = count;
+    node.type = createPointerType({ ...element }, 1);
+    node.llvmType = LLVMType.PTR;
+    return node;
+  }
+
+  // simd module calls are lowered inline. The per-type functions
+  // (f32x4_load, ...) carry their SIMD type in the name; the generic ones
+  // take it from their first argument.
+  private analyzeSimdCall(node: CallExpr): CallExpr {
+    const funcName = node.callee.value;
+    const perType = funcName.match(/^(\w+)_(load|store|splat)$/);
+    let resultType: string;
+
+    if (perType) {
+      resultType = perType[1];
+      this.analyzeSimdPerTypeCall(node, perType[1], perType[2]);
+      if (perType[2] === "store") resultType = "void";
+    } else {
+      node.arguments = node.arguments.map((arg) =>
+        funcName === "shuffle" && arg.kind === "ArrayLiteral"
+          ? arg
+          : this.analyzeNode(arg) as Expr
+      );
+      const simdType = this.expectSimdArgument(node, 0);
+
+      switch (funcName) {
+        case "shuffle":
+          resultType = this.analyzeShuffleMask(node, simdType);
+          break;
+        case "with_lane":
+          this.checkSimdLane(node.arguments[1] as Expr, simdType);
+          this.checkSimdScalar(node.arguments[2] as Expr, simdType);
+          resultType = simdType;
+          break;
+        default: // reduce_add, reduce_mul, reduce_min, reduce_max
+          resultType = this.typeChecker.simdLaneType(simdType);
+      }
+    }
+
+    node.type = createTypeInfo(resultType as TypesNative);
+    node.llvmType = this.typeChecker.mapToLLVMType(resultType) as LLVMType;
+    return node;
+  }
+
+  private analyzeSimdPerTypeCall(
+    node: CallExpr,
+    simdType: string,
+    operation: string,
+  ): void {
+    node.arguments = node.arguments.map((arg) => this.analyzeNode(arg));
+
+    if (operation === "splat") {
+      this.checkSimdScalar(node.arguments[0] as Expr, simdType);
+      return;
+    }
+
+    // load/store: (array, index[, value]) on a one-dimensional array whose
+    // elements are floats for float lanes and integers for integer lanes
+    const array = node.arguments[0] as Expr;
+    const symbol = array.kind === "Identifier"
+      ? this.lookupSymbol(array.value)
+      : undefined;
+    const floatLanes = this.typeChecker.simdLaneType(simdType) === "double";
+    const element = String(array.type.baseType);
+    const matches = floatLanes
+      ? element === "double" || element === "float"
+      : element === "int" || element === "i64";
+
+    if (
+      !symbol || !array.type.isArray || array.type.dimensions != 1 ||
+      !matches
+    ) {
+      const expected = floatLanes ? "float[]" : "int[] or i64[]";
+      this.reporter.addError(
+        array.loc,
+        `Function '${node.callee.value}' expects an array of type '${expected}', but got '${
+          typeInfoToString(array.type)
+        }'`,
+      );
+      throw new Error(
+        `Function '${node.callee.value}' expects an array of type '${expected}', but got '${
+          typeInfoToString(array.type)
+        }'`,
+      );
+    }
+
+    const index = node.arguments[1] as Expr;
+    if (!this.typeChecker.isNumericType(index.type.baseType)) {
+      this.reporter.addError(
+        index.loc,
+        `Function '${node.callee.value}' expects a numeric index, but got '${index.type.baseType}'`,
+      );
+      throw new Error(
+        `Function '${node.callee.value}' expects a numeric index, but got '${index.type.baseType}'`,
+      );
+    }
+
+    if (operation === "store") {
+      if (!symbol.mutable) {
+        this.reporter.addError(
+          array.loc,
+          `Cannot store into immutable array '${array.value}'`,
+        );
+        throw new Error(`Cannot store into immutable array '${array.value}'`);
+      }
+
+      const value = node.arguments[2] as Expr;
+      if (value.type.baseType !== simdType) {
+        this.reporter.addError(
+          value.loc,
+          `Function '${node.callee.value}' expects a value of type '${simdType}', but got '${
+            typeInfoToString(value.type)
+          }'`,
+        );
+        throw new Error(
+          `Function '${node.callee.value}' expects a value of type '${simdType}', but got '${
+            typeInfoToString(value.type)
+          }'`,
+        );
+      }
+    }
+  }
+
+  // shuffle(a, b, [i, ...]) picks lanes from the concatenation of a and b;
+  // the mask length decides the lane count of the result.
+  private analyzeShuffleMask(node: CallExpr, simdType: string): string {
+    const other = node.arguments[1] as Expr;
+    if (other.type.baseType !== simdType) {
+      this.reporter.addError(
+        other.loc,
+        `Function 'shuffle' expects two values of type '${simdType}', but got '${
+          typeInfoToString(other.type)
+        }'`,
+      );
+      throw new Error(
+        `Function 'shuffle' expects two values of type '${simdType}', but got '${
+          typeInfoToString(other.type)
+        }'`,
+      );
+    }
+
+    const mask = node.arguments[2] as Expr;
+    const { lanes, element } = SimdTypes[simdType];
+
+    if (
+      mask.kind !== "ArrayLiteral" ||
+      !(mask as ArrayLiteral).value.every((lane) =>
+        lane.kind === "IntLiteral" && Number(lane.value) >= 0 &&
+        Number(lane.value) < lanes * 2
+      )
+    ) {
+      this.reporter.addError(
+        mask.loc,
+        `The shuffle mask must be an array literal of lane numbers between 0 and ${
+          lanes * 2 - 1
+        }`,
+      );
+      throw new Error(
+        `The shuffle mask must be an array literal of lane numbers between 0 and ${
+          lanes * 2 - 1
+        }`,
+      );
+    }
+
+    const count = (mask as ArrayLiteral).value.length;
+    const resultType = this.typeChecker.simdTypeFor(element, count);
+    if (!resultType) {
+      this.reporter.addError(
+        mask.loc,
+        `No SIMD type has ${count} lanes of '${element}'`,
+      );
+      throw new Error(`No SIMD type has ${count} lanes of '${element}'`);
+    }
+
+    return resultType;
+  }
+
+  private expectSimdArgument(node: CallExpr, index: number): string {
+    const arg = node.arguments[index] as Expr;
+    if (!this.isSimdSymbol(arg.type)) {
+      this.reporter.addError(
+        arg.loc,
+        `Function '${node.callee.value}' expects a SIMD vector, but got '${
+          typeInfoToString(arg.type)
+        }'`,
+      );
+      throw new Error(
+        `Function '${node.callee.value}' expects a SIMD vector, but got '${
+          typeInfoToString(arg.type)
+        }'`,
+      );
+    }
+    return String(arg.type.baseType);
+  }
+
+  private checkSimdScalar(analyzed: Expr, simdType: string): Expr {
+    const type = analyzed.type;
+
+    if (
+      !this.typeChecker.isNumericType(type.baseType) || type.isArray ||
+      type.isPointer
+    ) {
+      this.reporter.addError(
+        analyzed.loc,
+        `Lanes of '${simdType}' cannot hold a value of type '${
+          typeInfoToString(type)
+        }'`,
+      );
+      throw new Error(
+        `Lanes of '${simdType}' cannot hold a value of type '${
+          typeInfoToString(type)
+        }'`,
+      );
+    }
+
+    return analyzed;
+  }
+
+  // Lane numbers known at compile time must be in range
+  private checkSimdLane(index: Expr, simdType: string): void {
+    const lanes = SimdTypes[simdType].lanes;
+
+    if (!this.typeChecker.isNumericType(index.type.baseType)) {
+      this.reporter.addError(
+        index.loc,
+        `Lane index must be numeric, but got '${index.type.baseType}'`,
+      );
+      throw new Error(
+        `Lane index must be numeric, but got '${index.type.baseType}'`,
+      );
+    }
+
+    if (
+      index.kind === "IntLiteral" &&
+      (Number(index.value) < 0 || Number(index.value) >= lanes)
+    ) {
+      this.reporter.addError(
+        index.loc,
+        `Lane ${index.value} is out of range for '${simdType}' (${lanes} lanes)`,
+      );
+      throw new Error(
+        `Lane ${index.value} is out of range for '${simdType}' (${lanes} lanes)`,
+      );
+    }
+  }
+
+  // `new s: str = ...` keeps its declared type; a plain string or literal
+  // initializer is converted (and measured) when it is stored.
+  private analyzeFatStringDeclaration(
+    decl: VariableDeclaration,
+  ): VariableDeclaration {
+    this.requireStringModule(decl.type, decl.loc);
+
+    if (this.currentScope().has(decl.id.value)) {
+      this.reporter.addError(
+        decl.id.loc,
+        `Variable '${decl.id.value}' is already defined in this scope`,
+      );
+      throw new Error(
+        `Variable '${decl.id.value}' is already defined in this scope at ${decl.loc.line}:${decl.loc.start}`,
+      );
+    }
+
+    const value = this.analyzeNode(decl.value) as Expr;
+    if (
+      !this.isFatStringSymbol(value.type) && !this.isFatStringSource(value.type)
+    ) {
+      this.reporter.addError(
+        value.loc,
+        `Cannot initialize 'str' with a value of type '${
+          typeInfoToString(value.type)
+        }'`,
+      );
+      throw new Error(
+        `Cannot initialize 'str' with a value of type '${
+          typeInfoToString(value.type)
+        }'`,
+      );
+    }
+
+    const llvmType = this.typeChecker.mapToLLVMType("str");
+
+    this.defineSymbol({
+      id: decl.id.value,
+      sourceType: decl.type,
+      llvmType: llvmType,
+      mutable: decl.mutable,
+      initialized: true,
+      loc: decl.loc,
+    });
+
+    return {
+      ...decl,
+      value: value,
+      llvmType: llvmType,
+    };
+  }
+
+  private isFatStringSymbol(type: TypeInfo): boolean {
+    return type.baseType === "str" && !type.isArray && !type.isPointer &&
+      !type.isVector && !type.isSlice;
+  }
+
+  // Plain strings convert to `str` by borrowing their bytes
+  private isFatStringSource(type: TypeInfo): boolean {
+    return type.baseType === "string" && !type.isArray && !type.isVector &&
+      !type.isPointer && !type.isSlice;
+  }
+
+  private requireStringModule(type: TypeInfo, loc: Loc): void {
+    if (this.importedModules.has("string")) return;
+
+    this.reporter.addError(
+      loc,
+      `Type '${typeInfoToString(type)}' requires the 'string' module`,
+      [this.reporter.makeSuggestion('Add `import "string"` to this file.')],
+    );
+    throw new Error(
+      `Type '${typeInfoToString(type)}' requires the 'string' module`,
+    );
+  }
+
+  // `new mut hits: atomic<int> = 0`. Nothing else can see the variable
+  // yet, so the initial value is a plain store.
+  private analyzeAtomicDeclaration(
+    decl: VariableDeclaration,
+  ): VariableDeclaration {
+    this.requireAtomicModule(decl.type, decl.loc);
+
+    if (this.currentScope().has(decl.id.value)) {
+      this.reporter.addError(
+        decl.id.loc,
+        `Variable '${decl.id.value}' is already defined in this scope`,
+      );
+      throw new Error(
+        `Variable '${decl.id.value}' is already defined in this scope at ${decl.loc.line}:${decl.loc.start}`,
+      );
+    }
+
+    const atomicType = String(decl.type.baseType);
+    const llvmType = this.typeChecker.mapToLLVMType(atomicType);
+    const value = this.checkAtomicValue(
+      this.analyzeNode(decl.value) as Expr,
+      atomicType,
+    );
+
+    this.defineSymbol({
+      id: decl.id.value,
+      sourceType: decl.type,
+      llvmType: llvmType,
+      mutable: decl.mutable,
+      initialized: true,
+      loc: decl.loc,
+    });
+
+    return {
+      ...decl,
+      value: value,
+      llvmType: llvmType,
+    };
+  }
+
+  // atomic_* calls take an atomic variable first (`&` is optional) and a
+  // memory ordering (`relaxed`, `acquire`, ...) last.
+  private analyzeAtomicCall(node: CallExpr): CallExpr {
+    const funcName = node.callee.value;
+    const ordering = this.checkAtomicOrdering(node);
+
+    if (funcName === "atomic_fence") {
+      if (ordering === "monotonic") {
+        this.reporter.addError(
+          node.arguments[0].loc,
+          "A fence cannot be 'relaxed'",
+        );
+        throw new Error("A fence cannot be 'relaxed'");
+      }
+      return node;
+    }
+
+    const atomicType = this.expectAtomicTarget(node);
+    const element = AtomicTypes[atomicType].element;
+
+    for (let i = 1; i < node.arguments.length - 1; i++) {
+      node.arguments[i] = this.checkAtomicValue(
+        this.analyzeNode(node.arguments[i]) as Expr,
+        atomicType,
+      );
+    }
+
+    const invalid: Record<string, string[]> = {
+      atomic_load: ["release", "acq_rel"],
+      atomic_store: ["acquire", "acq_rel"],
+    };
+    const order = node.arguments[node.arguments.length - 1];
+    if (invalid[funcName]?.includes(ordering)) {
+      this.reporter.addError(
+        order.loc,
+        `'${order.value}' is not a valid ordering for ${funcName}`,
+      );
+      throw new Error(
+        `'${order.value}' is not a valid ordering for ${funcName}`,
+      );
+    }
+
+    if (
+      (funcName === "atomic_fetch_add" || funcName === "atomic_fetch_sub") &&
+      element === "ptr"
+    ) {
+      this.reporter.addError(
+        node.loc,
+        `${funcName} needs an integer atomic, not '${atomicType}'`,
+      );
+      throw new Error(
+        `${funcName} needs an integer atomic, not '${atomicType}'`,
+      );
+    }
+
+    if (funcName === "atomic_cas") {
+      node.type = createTypeInfo("bool");
+    } else if (funcName === "atomic_store") {
+      node.type = createTypeInfo("void");
+    } else {
+      node.type = element === "ptr"
+        ? createPointerType(createTypeInfo("null"), 1)
+        : createTypeInfo(element as TypesNative);
+    }
+    node.llvmType = node.type.isPointer
+      ? LLVMType.PTR
+      : this.typeChecker.mapToLLVMType(node.type.baseType) as LLVMType;
+    return node;
+  }
+
+  private checkAtomicOrdering(node: CallExpr): AtomicOrdering {
+    const order = node.arguments[node.arguments.length - 1];
+
+    if (
+      order.kind !== "Identifier" ||
+      !Object.hasOwn(ATOMIC_ORDERINGS, order.value)
+    ) {
+      this.reporter.addError(
+        order.loc,
+        `${node.callee.value} expects a memory ordering as its last argument`,
+        [
+          this.reporter.makeSuggestion(
+            "Use relaxed, acquire, release, acq_rel or seq_cst.",
+          ),
+        ],
+      );
+      throw new Error(
+        `${node.callee.value} expects a memory ordering as its last argument`,
+      );
+    }
+
+    return ATOMIC_ORDERINGS[order.value];
+  }
+
+  private expectAtomicTarget(node: CallExpr): string {
+    let target = node.arguments[0];
+    if (
+      target.kind === "UnaryExpr" && (target as UnaryExpr).operator === "&"
+    ) {
+      target = (target as UnaryExpr).operand;
+    }
+
+    const symbol = target.kind === "Identifier"
+      ? this.lookupSymbol(target.value)
+      : undefined;
+
+    if (!symbol || !this.isAtomicSymbol(symbol.sourceType)) {
+      this.reporter.addError(
+        target.loc,
+        `${node.callee.value} expects an atomic variable as its first argument`,
+      );
+      throw new Error(
+        `${node.callee.value} expects an atomic variable as its first argument`,
+      );
+    }
+
+    node.arguments[0] = this.analyzeNode(target) as Expr;
+    return String(symbol.sourceType.baseType);
+  }
+
+  // Integer atomics take int/i64 values; atomic<ptr> takes any pointer
+  private checkAtomicValue(value: Expr, atomicType: string): Expr {
+    const element = AtomicTypes[atomicType].element;
+    const type = value.type;
+    const valid = element === "ptr"
+      ? this.typeChecker.isPointerType(type) ||
+        ["null", "ptr", "string"].includes(String(type.baseType))
+      : !type.isPointer && !type.isArray &&
+        ["int", "i64", "binary"].includes(String(type.baseType));
+
+    if (!valid) {
+      this.reporter.addError(
+        value.loc,
+        `Cannot use a '${typeInfoToString(type)}' value with '${atomicType}'`,
+      );
+      throw new Error(
+        `Cannot use a '${typeInfoToString(type)}' value with '${atomicType}'`,
+      );
+    }
+
+    return value;
+  }
+
+  private isAtomicSymbol(type: TypeInfo): boolean {
+    return this.typeChecker.isAtomicType(type.baseType) && !type.isArray &&
+      !type.isPointer && !type.isVector && !type.isSlice;
+  }
+
+  private requireAtomicModule(type: TypeInfo, loc: Loc): void {
+    if (this.importedModules.has("atomic")) return;
+
+    this.reporter.addError(
+      loc,
+      `Atomic type '${typeInfoToString(type)}' requires the 'atomic' module`,
+      [this.reporter.makeSuggestion('Add `import "atomic"` to this file.')],
+    );
+    throw new Error(
+      `Atomic type '${typeInfoToString(type)}' requires the 'atomic' module`,
+    );
+  }
+
+  private isSimdSymbol(type: TypeInfo): boolean {
+    return this.typeChecker.isSimdType(type.baseType) && !type.isArray &&
+      !type.isPointer && !type.isVector && !type.isSlice;
+  }
+
+  private requireSimdModule(type: TypeInfo, loc: Loc): void {
+    if (this.importedModules.has("simd")) return;
+
+    this.reporter.addError(
+      loc,
+      `SIMD type '${typeInfoToString(type)}' requires the 'simd' module`,
+      [this.reporter.makeSuggestion('Add `import "simd"` to this file.')],
+    );
+    throw new Error(
+      `SIMD type '${typeInfoToString(type)}' requires the 'simd' module`,
+    );
+  }
+
+  private analyzeIncrementExpr(expr: IncrementExpr): IncrementExpr {
+    const analyzedValue = this.analyzeNode(expr.value) as Expr;
+
+    if (analyzedValue.kind !== "Identifier") {
+      this.reporter.addError(
+        expr.loc,
+        "Cannot increment non-variable expression",
+      );
+      throw new Error(
+        `Cannot increment non-variable expression at ${expr.loc.line}:${expr.loc.start}`,
+      );
+    }
+
+    if (
+      analyzedValue.type.baseType !== "int" &&
+      analyzedValue.type.baseType !== "float"
+    ) {
+      this.reporter.addError(
+        expr.loc,
+        `Cannot increment variable of type '${analyzedValue.type}'`,
+      );
+      throw new Error(
+        `Cannot increment variable of type '${analyzedValue.type}' at ${expr.loc.line}:${expr.loc.start}`,
+      );
+    }
+
+    const symbol = this.lookupSymbol((analyzedValue as Identifier).value);
+    if (symbol && !symbol.mutable) {
+      this.reporter.addError(
+        expr.loc,
+        `Cannot increment immutable variable '${
+          (analyzedValue as Identifier).value
+        }'`,
+      );
+      throw new Error(
+        `Cannot increment immutable variable '${
+          (analyzedValue as Identifier).value
+        }' at ${expr.loc.line}:${expr.loc.start}`,
+      );
+    }
+
+    this.checkParallelWrite(analyzedValue as Identifier);
+
+    return {
+      ...expr,
+      value: analyzedValue,
+      type: analyzedValue.type,
+      llvmType: (analyzedValue as Expr).llvmType,
+    };
+  }
+
+  private analyzeDecrementExpr(expr: DecrementExpr): DecrementExpr {
+    const analyzedValue = this.analyzeNode(expr.value) as Expr;
+
+    if (analyzedValue.kind !== "Identifier") {
+      this.reporter.addError(
+        expr.loc,
+        "Cannot decrement non-variable expression",
+      );
+      throw new Error(
+        `Cannot decrement non-variable expression at ${expr.loc.line}:${expr.loc.start}`,
+      );
+    }
+
+    if (
+      analyzedValue.type.baseType !== "int" &&
+      analyzedValue.type.baseType !== "float"
+    ) {
+      this.reporter.addError(
+        expr.loc,
+        `Cannot decrement variable of type '${analyzedValue.type}'`,
+      );
+      throw new Error(
+        `Cannot decrement variable of type '${analyzedValue.type}' at ${expr.loc.line}:${expr.loc.start}`,
+      );
     }
 
     const symbol = this.lookupSymbol((analyzedValue as Identifier).value);
@@ -1317,6 +2590,8 @@ export class Semantic {
       );
     }
 
+    this.checkParallelWrite(analyzedValue as Identifier);
+
     return {
       ...expr,
       value: analyzedValue,
@@ -1325,6 +2600,32 @@ export class Semantic {
     };
   }
 
+  // Every pfor thread sees the same outer variables, so the body may only
+  // write its own locals and the variables of its reduce clauses. Struct
+  // fields and vec_* mutators count as writes; atomic_* calls do not.
+  private checkParallelWrite(id: Identifier): void {
+    if (
+      !this.parallelOuter?.has(id.value) ||
+      this.parallelReductions.has(id.value) ||
+      this.currentScope().has(id.value)
+    ) {
+      return;
+    }
+
+    this.reporter.addError(
+      id.loc,
+      `'${id.value}' is shared by every pfor thread and cannot be modified`,
+      [
+        this.reporter.makeSuggestion(
+          `List it in a reduce clause or declare it inside the loop.`,
+        ),
+      ],
+    );
+    throw new Error(
+      `'${id.value}' is shared by every pfor thread and cannot be modified`,
+    );
+  }
+
   private pushScope(): void {
     this.scopeStack.push(new Map());
   }
@@ -7,7 +7,13 @@
  * See the LICENSE file in the project root for full license information.
  */
 import { DiagnosticReporter } from "../error/diagnosticReporter.ts";
-import { createPointerType, createTypeInfo } from "../frontend/parser/ast.ts";
+import {
+  createPointerType,
+  createSliceType,
+  createTypeInfo,
+} from "../frontend/parser/ast.ts";
+import { SimdTypes } from "../frontend/values.ts";
+import { AtomicOrdering } from "../ts-ir/types/IRTypes.ts";
 import {
   StdLibFunction,
   StdLibModule,
@@ -51,21 +57,183 @@ function createIOModule(): StdLibModule {
     .defineFunction("read_line")
     .returns(createTypeInfo("string"))
     .done()
+    // Buffered writer: writer_new(fd, size), 0 picks a 64 KB buffer.
+    // Writers are flushed at exit; flush(w) forces the text out.
+    .defineFunction("writer_new")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("int", "i64")
+    .done()
+    .defineFunction("write_str")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "view")
+    .withIR("declare void @write_str(i8*, i8*, i64)")
+    .done()
+    // write_char(w, code)
+    .defineFunction("write_char")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "int")
+    .done()
+    .defineFunction("write_int")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "i64")
+    .done()
+    .defineFunction("write_f64")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "double")
+    .done()
+    .defineFunction("flush")
+    .llvmName("writer_flush")
+    .returns(createTypeInfo("void"))
+    .withParams("null")
+    .done()
+    // writer_close(w): flushes and releases the writer
+    .defineFunction("writer_close")
+    .returns(createTypeInfo("void"))
+    .withParams("null")
+    .done()
+    // read_all() -> string[:], all of stdin (mapped when it is a file)
+    .defineFunction("read_all")
+    .returns(createSliceType("string"))
+    .withIR("declare void @read_all(i8*)")
+    .done()
+    // Line reader: lines_new(fd), then lines_next(r) and lines_view(r)
+    // until lines_next is false. A view is valid until the next line.
+    .defineFunction("lines_new")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("int")
+    .done()
+    .defineFunction("lines_next")
+    .returns(createTypeInfo("bool"))
+    .withParams("null")
+    .done()
+    .defineFunction("lines_view")
+    .returns(createSliceType("string"))
+    .withParams("null")
+    .withIR("declare void @lines_view(i8*, i8*)")
+    .done()
+    .defineFunction("lines_close")
+    .returns(createTypeInfo("void"))
+    .withParams("null")
+    .done()
+    // Scanner: scanner_new(fd), then next_i64, next_f64 or next_token
+    // (a view) while has_next(sc) is true
+    .defineFunction("scanner_new")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("int")
+    .done()
+    .defineFunction("has_next")
+    .returns(createTypeInfo("bool"))
+    .withParams("null")
+    .done()
+    .defineFunction("next_i64")
+    .returns(createTypeInfo("i64"))
+    .withParams("null")
+    .done()
+    .defineFunction("next_f64")
+    .returns(createTypeInfo("double"))
+    .withParams("null")
+    .done()
+    .defineFunction("next_token")
+    .returns(createSliceType("string"))
+    .withParams("null")
+    .withIR("declare void @next_token(i8*, i8*)")
+    .done()
+    .defineFunction("scanner_close")
+    .returns(createTypeInfo("void"))
+    .withParams("null")
+    .done()
+    // wtime(): monotonic wall-clock seconds, for timing
+    .defineFunction("wtime")
+    .returns(createTypeInfo("double"))
+    .withParams()
+    .done()
     // Build
     .defineFlags("-lc")
     .build();
 }
 
+// Files by descriptor from file.c. The fd from file_open also works with
+// writer_new, lines_new and scanner_new from io.
+function createFileModule(): StdLibModule {
+  return defineModule("file")
+    // file_open(path, mode): "r", "w", "a", "r+" or "w+"
+    .defineFunction("file_open")
+    .returns(createTypeInfo("int"))
+    .withParams("string", "string")
+    .done()
+    .defineFunction("file_close")
+    .returns(createTypeInfo("void"))
+    .withParams("int")
+    .done()
+    .defineFunction("file_size")
+    .returns(createTypeInfo("i64"))
+    .withParams("int")
+    .done()
+    // file_pread(fd, buffer, count, offset) -> bytes read
+    .defineFunction("file_pread")
+    .returns(createTypeInfo("i64"))
+    .withParams("int", "null", "i64", "i64")
+    .done()
+    // file_pwrite(fd, text, offset) -> bytes written
+    .defineFunction("file_pwrite")
+    .returns(createTypeInfo("i64"))
+    .withParams("int", "view", "i64")
+    .withIR("declare i64 @file_pwrite(i32, i8*, i64, i64)")
+    .done()
+    // file_map(fd) -> string[:], the whole file mapped read-only
+    .defineFunction("file_map")
+    .returns(createSliceType("string"))
+    .withParams("int")
+    .withIR("declare void @file_map(i8*, i32)")
+    .done()
+    .defineFunction("file_unmap")
+    .returns(createTypeInfo("void"))
+    .withParams("view")
+    .withIR("declare void @file_unmap(i8*, i64)")
+    .done()
+    // madvise hints for a map or a slice of one
+    .defineFunction("file_sequential")
+    .returns(createTypeInfo("void"))
+    .withParams("view")
+    .withIR("declare void @file_sequential(i8*, i64)")
+    .done()
+    .defineFunction("file_willneed")
+    .returns(createTypeInfo("void"))
+    .withParams("view")
+    .withIR("declare void @file_willneed(i8*, i64)")
+    .done()
+    // Build
+    .build();
+}
+
 // Create Math module with fluent API
+// Math calls with literal arguments are evaluated by the optimizer
+export const MATH_FOLDS = new Map<string, (...args: number[]) => number>([
+  ["sin", Math.sin],
+  ["cos", Math.cos],
+  ["tan", Math.tan],
+  ["log", Math.log],
+  ["exp", Math.exp],
+  ["sqrt", Math.sqrt],
+  ["pow", Math.pow],
+  ["pi", () => Math.PI],
+  ["e", () => Math.E],
+]);
+
+// sin/cos/log/exp/sqrt/pow map to LLVM intrinsics, which the optimizer
+// can fold, hoist and vectorize (see --veclib); tan has no intrinsic and
+// stays a libm call.
 function createMathModule(): StdLibModule {
   return defineModule("math")
     // sin(x)
     .defineFunction("sin")
+    .llvmName("llvm.sin.f64")
     .returns(createTypeInfo("double"))
     .withParams("double")
     .done()
     // cos(x)
     .defineFunction("cos")
+    .llvmName("llvm.cos.f64")
     .returns(createTypeInfo("double"))
     .withParams("double")
     .done()
@@ -76,21 +244,25 @@ function createMathModule(): StdLibModule {
     .done()
     // log(x)
     .defineFunction("log")
+    .llvmName("llvm.log.f64")
     .returns(createTypeInfo("double"))
     .withParams("double")
     .done()
     // exp(x)
     .defineFunction("exp")
+    .llvmName("llvm.exp.f64")
     .returns(createTypeInfo("double"))
     .withParams("double")
     .done()
     // sqrt(x)
     .defineFunction("sqrt")
+    .llvmName("llvm.sqrt.f64")
     .returns(createTypeInfo("double"))
     .withParams("double")
     .done()
     // pow(x, y)
     .defineFunction("pow")
+    .llvmName("llvm.pow.f64")
     .returns(createTypeInfo("double"))
     .withParams("double", "double")
     .done()
@@ -140,54 +312,272 @@ function createStringModule(): StdLibModule {
     .withParams("string")
     .done()
     .defineFunction("strcat")
-    .llvmName("string_concat")
+    .llvmName("str_concat")
     .returns(createTypeInfo("string"))
     .withParams("string", "string")
     .done()
+    // String builder: sb_new(capacity), 0 picks a small default
+    .defineFunction("sb_new")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("i64")
+    .done()
+    .defineFunction("sb_append")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "string")
+    .done()
+    .defineFunction("sb_append_int")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "i64")
+    .done()
+    .defineFunction("sb_append_float")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "double")
+    .done()
+    // sb_append_char(sb, code)
+    .defineFunction("sb_append_char")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "int")
+    .done()
+    // sb_reserve(sb, extra): room for `extra` more bytes
+    .defineFunction("sb_reserve")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "i64")
+    .done()
+    .defineFunction("sb_len")
+    .returns(createTypeInfo("i64"))
+    .withParams("null")
+    .done()
+    .defineFunction("sb_clear")
+    .returns(createTypeInfo("void"))
+    .withParams("null")
+    .done()
+    // sb_finish(sb): the built string, without copying; frees the builder
+    .defineFunction("sb_finish")
+    .returns(createTypeInfo("string"))
+    .withParams("null")
+    .done()
+    // slice(s, start, end) -> string[:] (also arrays, vectors and views)
+    .defineFunction("slice")
+    .returns(createSliceType("string"))
+    .withParams("id", "i64", "i64")
+    .done()
+    // slice_len(view)
+    .defineFunction("slice_len")
+    .returns(createTypeInfo("i64"))
+    .withParams("id")
+    .done()
+    // Views are passed to C as a (pointer, length) pair
+    .defineFunction("view_equals")
+    .returns(createTypeInfo("bool"))
+    .withParams("view", "view")
+    .withIR("declare i1 @view_equals(i8*, i64, i8*, i64)")
+    .done()
+    .defineFunction("view_find")
+    .returns(createTypeInfo("i64"))
+    .withParams("view", "view")
+    .withIR("declare i64 @view_find(i8*, i64, i8*, i64)")
+    .done()
+    .defineFunction("view_starts_with")
+    .returns(createTypeInfo("bool"))
+    .withParams("view", "view")
+    .withIR("declare i1 @view_starts_with(i8*, i64, i8*, i64)")
+    .done()
+    .defineFunction("view_ends_with")
+    .returns(createTypeInfo("bool"))
+    .withParams("view", "view")
+    .withIR("declare i1 @view_ends_with(i8*, i64, i8*, i64)")
+    .done()
+    .defineFunction("view_to_int")
+    .returns(createTypeInfo("i64"))
+    .withParams("view")
+    .withIR("declare i64 @view_to_int(i8*, i64)")
+    .done()
+    .defineFunction("view_to_string")
+    .returns(createTypeInfo("string"))
+    .withParams("view")
+    .withIR("declare i8* @view_to_string(i8*, i64)")
+    .done()
+    .defineFunction("view_print")
+    .returns(createTypeInfo("void"))
+    .withParams("view")
+    .withIR("declare void @view_print(i8*, i64)")
+    .done()
+    // Search: SIMD kernels picked at startup; indices are byte offsets and
+    // -1 means not found
+    .defineFunction("str_find")
+    .returns(createTypeInfo("i64"))
+    .withParams("view", "view")
+    .withIR("declare i64 @str_find(i8*, i64, i8*, i64)")
+    .done()
+    .defineFunction("str_rfind")
+    .returns(createTypeInfo("i64"))
+    .withParams("view", "view")
+    .withIR("declare i64 @str_rfind(i8*, i64, i8*, i64)")
+    .done()
+    .defineFunction("str_count")
+    .returns(createTypeInfo("i64"))
+    .withParams("view", "view")
+    .withIR("declare i64 @str_count(i8*, i64, i8*, i64)")
+    .done()
+    // str_split(s, sep, from): end of the field starting at `from`
+    .defineFunction("str_split")
+    .returns(createTypeInfo("i64"))
+    .withParams("view", "view", "i64")
+    .withIR("declare i64 @str_split(i8*, i64, i8*, i64, i64)")
+    .done()
+    // Byte sets: any byte of the second argument
+    .defineFunction("str_find_any")
+    .returns(createTypeInfo("i64"))
+    .withParams("view", "view")
+    .withIR("declare i64 @str_find_any(i8*, i64, i8*, i64)")
+    .done()
+    .defineFunction("str_skip_any")
+    .returns(createTypeInfo("i64"))
+    .withParams("view", "view")
+    .withIR("declare i64 @str_skip_any(i8*, i64, i8*, i64)")
+    .done()
+    .defineFunction("str_contains_any")
+    .returns(createTypeInfo("bool"))
+    .withParams("view", "view")
+    .withIR("declare i1 @str_contains_any(i8*, i64, i8*, i64)")
+    .done()
+    .defineFunction("str_compare")
+    .returns(createTypeInfo("int"))
+    .withParams("view", "view")
+    .withIR("declare i32 @str_compare(i8*, i64, i8*, i64)")
+    .done()
+    // Numbers: parse_*(s, &stop) store where the number ends in `stop` (-1
+    // when there is none, -2 when it is out of range); fmt_*(buf, cap, v)
+    // return the length written, or -1 when `cap` bytes are not enough
+    .defineFunction("parse_i64")
+    .returns(createTypeInfo("i64"))
+    .withParams("view", "null")
+    .withIR("declare i64 @parse_i64(i8*, i64, i64*)")
+    .done()
+    .defineFunction("parse_f64")
+    .returns(createTypeInfo("double"))
+    .withParams("view", "null")
+    .withIR("declare double @parse_f64(i8*, i64, i64*)")
+    .done()
+    .defineFunction("fmt_i64")
+    .returns(createTypeInfo("i64"))
+    .withParams("null", "i64", "i64")
+    .done()
+    .defineFunction("fmt_f64")
+    .returns(createTypeInfo("i64"))
+    .withParams("null", "i64", "double")
+    .done()
+    // Like atoi, but clamps to the int range instead of overflowing
+    .defineFunction("str_to_int")
+    .returns(createTypeInfo("int"))
+    .withParams("string")
+    .done()
+    // Fat strings: str_len(s) is O(1) and s.cstr() borrows the text
+    .defineFunction("str_len")
+    .returns(createTypeInfo("i64"))
+    .withParams("str")
+    .done()
+    .defineFunction("cstr")
+    .returns(createTypeInfo("string"))
+    .withParams("str")
+    .done()
+    // str_from(view): an owned copy, stored inline when it is short
+    .defineFunction("str_from")
+    .returns(createTypeInfo("str"))
+    .withParams("view")
+    .withIR("declare void @str_from(%farpy.str*, i8*, i64)")
+    .done()
+    .defineFunction("str_cat")
+    .returns(createTypeInfo("str"))
+    .withParams("view", "view")
+    .withIR("declare void @str_cat(%farpy.str*, i8*, i64, i8*, i64)")
+    .done()
     .build();
 }
 
+// Each conversion is at most two instructions, defined inline in the IR so
+// it costs nothing at the call site and does not block vectorization. Farpy
+// float lowers to an LLVM double, so dtof rounds through an LLVM float and
+// widens back. A step is [instruction, result type].
+function conversionIR(
+  name: string,
+  from: string,
+  ...steps: [string, string][]
+): string {
+  const lines = [];
+  let value = "%x";
+  let type = from;
+  for (const [i, [instruction, result]] of steps.entries()) {
+    lines.push(`  %r${i} = ${instruction} ${type} ${value} to ${result}`);
+    value = `%r${i}`;
+    type = result;
+  }
+  return [
+    `define internal ${type} @${name}(${from} %x) alwaysinline nounwind readnone {`,
+    ...lines,
+    `  ret ${type} ${value}`,
+    "}",
+  ].join("\n");
+}
+
 function createTypesModule(): StdLibModule {
   return defineModule("types")
+    .defineIROnly()
     // Float to Double Conversion
     .defineFunction("ftod")
     .returns(createTypeInfo("double"))
     .withParams("float")
+    .withIR(conversionIR("ftod", "double"))
     .done()
     // Int to Double Conversion
     .defineFunction("itod")
     .returns(createTypeInfo("double"))
     .withParams("int")
+    .withIR(conversionIR("itod", "i32", ["sitofp", "double"]))
     .done()
     // Int to Float Conversion
     .defineFunction("itof")
     .returns(createTypeInfo("float"))
     .withParams("int")
+    .withIR(conversionIR("itof", "i32", ["sitofp", "double"]))
     .done()
     // Double to Float Conversion
     .defineFunction("dtof")
     .returns(createTypeInfo("float"))
     .withParams("double")
+    .withIR(
+      conversionIR("dtof", "double", ["fptrunc", "float"], ["fpext", "double"]),
+    )
     .done()
     // Double to Int Conversion
     .defineFunction("dtoi")
     .returns(createTypeInfo("int"))
     .withParams("double")
+    .withIR(conversionIR("dtoi", "double", ["fptosi", "i32"]))
     .done()
     // Float to Int Conversion
     .defineFunction("ftoi")
     .returns(createTypeInfo("int"))
     .withParams("float")
+    .withIR(conversionIR("ftoi", "double", ["fptosi", "i32"]))
     .done()
     // Bool to Int Conversion
     .defineFunction("btoi")
     .returns(createTypeInfo("int"))
     .withParams("bool")
+    .withIR(conversionIR("btoi", "i1", ["zext", "i32"]))
     .done()
     // Build
     .build();
 }
 
+// alloc<T>(n) and alloc_zeroed<T>(n) are lowered inline to malloc/calloc
+// with sizeof(T) folded by LLVM; they never reach memory.c.
+export const ALLOC_FUNCTIONS = new Set(["alloc", "alloc_zeroed"]);
+
+// Functions called with a type argument, `alloc<T>(n)`
+export const TYPED_FUNCTIONS = new Set([...ALLOC_FUNCTIONS, "pool_new"]);
+
 function createMemoryModule(): StdLibModule {
   return defineModule("memory")
     // Float to Double Conversion
@@ -200,6 +590,317 @@ function createMemoryModule(): StdLibModule {
     .returns(createPointerType(createTypeInfo("null"), 1))
     .withParams("string")
     .done()
+    // alloc<T>(n): room for n values of T
+    .defineFunction("alloc")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("i64")
+    .done()
+    // alloc_zeroed<T>(n): same, filled with zeros
+    .defineFunction("alloc_zeroed")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("i64")
+    .done()
+    // Build
+    .build();
+}
+
+// Bump allocation from arena.c. `region { ... }` blocks call its
+// farpy_region_begin/end directly; string and I/O functions allocate from
+// the arena made current by arena_use() or by an enclosing region.
+function createArenaModule(): StdLibModule {
+  return defineModule("arena")
+    // arena_new(block_size): 0 picks the default block size
+    .defineFunction("arena_new")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("i64")
+    .done()
+    // arena_alloc(arena, size)
+    .defineFunction("arena_alloc")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("null", "i64")
+    .done()
+    // arena_reset(arena): releases everything in O(1)
+    .defineFunction("arena_reset")
+    .returns(createTypeInfo("void"))
+    .withParams("null")
+    .done()
+    // arena_free(arena)
+    .defineFunction("arena_free")
+    .returns(createTypeInfo("void"))
+    .withParams("null")
+    .done()
+    // arena_used(arena): bytes allocated since the last reset
+    .defineFunction("arena_used")
+    .returns(createTypeInfo("i64"))
+    .withParams("null")
+    .done()
+    // arena_use(arena): current arena for this thread, null for malloc
+    .defineFunction("arena_use")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("null")
+    .done()
+    // Build
+    .build();
+}
+
+// Object pools from pool.c. pool_new<T>() is lowered to
+// pool_create(sizeof(T), alignof(T)); the rest are plain calls.
+function createPoolModule(): StdLibModule {
+  return defineModule("pool")
+    // pool_new<T>(): a pool of T objects
+    .defineFunction("pool_new")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams()
+    .done()
+    // pool_alloc(pool): one object, O(1)
+    .defineFunction("pool_alloc")
+    .returns(createPointerType(createTypeInfo("null"), 1))
+    .withParams("null")
+    .done()
+    // pool_free(pool, object): O(1)
+    .defineFunction("pool_free")
+    .returns(createTypeInfo("void"))
+    .withParams("null", "null")
+    .done()
+    // pool_destroy(pool): releases every slab
+    .defineFunction("pool_destroy")
+    .returns(createTypeInfo("void"))
+    .withParams("null")
+    .done()
+    // pool_live(pool): objects allocated and not freed
+    .defineFunction("pool_live")
+    .returns(createTypeInfo("i64"))
+    .withParams("null")
+    .done()
+    // pool_slabs(pool): slabs taken from malloc
+    .defineFunction("pool_slabs")
+    .returns(createTypeInfo("i64"))
+    .withParams("null")
+    .done()
+    // pool_high_water(pool): most objects live at once
+    .defineFunction("pool_high_water")
+    .returns(createTypeInfo("i64"))
+    .withParams("null")
+    .done()
+    .defineFlags("-pthread")
+    // Build
+    .build();
+}
+
+// Calls into the vec module are lowered inline by the IR generator, one
+// copy per element type. Only the growth path lives in vec.c.
+export const VECTOR_FUNCTIONS = new Set([
+  "vec_push",
+  "vec_reserve",
+  "vec_len",
+  "vec_cap",
+  "vec_clear",
+  "vec_free",
+]);
+
+function createVecModule(): StdLibModule {
+  return defineModule("vec")
+    // vec_push(v, value)
+    .defineFunction("vec_push")
+    .returns(createTypeInfo("void"))
+    .withParams("id", "id")
+    .done()
+    // vec_reserve(v, n)
+    .defineFunction("vec_reserve")
+    .returns(createTypeInfo("void"))
+    .withParams("id", "i64")
+    .done()
+    // vec_len(v)
+    .defineFunction("vec_len")
+    .returns(createTypeInfo("i64"))
+    .withParams("id")
+    .done()
+    // vec_cap(v)
+    .defineFunction("vec_cap")
+    .returns(createTypeInfo("i64"))
+    .withParams("id")
+    .done()
+    // vec_clear(v)
+    .defineFunction("vec_clear")
+    .returns(createTypeInfo("void"))
+    .withParams("id")
+    .done()
+    // vec_free(v)
+    .defineFunction("vec_free")
+    .returns(createTypeInfo("void"))
+    .withParams("id")
+    .done()
+    // Build
+    .build();
+}
+
+// Atomic operations are single LLVM instructions emitted inline; the
+// module has no C source. The last argument of each is a memory ordering.
+export const ATOMIC_FUNCTIONS = new Set([
+  "atomic_load",
+  "atomic_store",
+  "atomic_exchange",
+  "atomic_fetch_add",
+  "atomic_fetch_sub",
+  "atomic_cas",
+  "atomic_fence",
+]);
+
+// Farpy ordering names and the LLVM orderings they stand for
+export const ATOMIC_ORDERINGS: Record<string, AtomicOrdering> = {
+  relaxed: "monotonic",
+  acquire: "acquire",
+  release: "release",
+  acq_rel: "acq_rel",
+  seq_cst: "seq_cst",
+};
+
+function createAtomicModule(): StdLibModule {
+  return defineModule("atomic").defineIROnly()
+    // atomic_load(a, order)
+    .defineFunction("atomic_load")
+    .returns(createTypeInfo("id"))
+    .withParams("id", "id")
+    .done()
+    // atomic_store(a, value, order)
+    .defineFunction("atomic_store")
+    .returns(createTypeInfo("void"))
+    .withParams("id", "id", "id")
+    .done()
+    // atomic_exchange(a, value, order): previous value
+    .defineFunction("atomic_exchange")
+    .returns(createTypeInfo("id"))
+    .withParams("id", "id", "id")
+    .done()
+    // atomic_fetch_add(a, value, order): previous value
+    .defineFunction("atomic_fetch_add")
+    .returns(createTypeInfo("id"))
+    .withParams("id", "id", "id")
+    .done()
+    // atomic_fetch_sub(a, value, order): previous value
+    .defineFunction("atomic_fetch_sub")
+    .returns(createTypeInfo("id"))
+    .withParams("id", "id", "id")
+    .done()
+    // atomic_cas(a, expected, desired, order): true if it was swapped
+    .defineFunction("atomic_cas")
+    .returns(createTypeInfo("bool"))
+    .withParams("id", "id", "id", "id")
+    .done()
+    // atomic_fence(order)
+    .defineFunction("atomic_fence")
+    .returns(createTypeInfo("void"))
+    .withParams("id")
+    .done()
+    // Build
+    .build();
+}
+
+// `pfor` loops call farpy_pfor() from parallel.c directly; these are the
+// knobs a program can reach.
+function createParallelModule(): StdLibModule {
+  return defineModule("parallel")
+    // parallel_threads(): threads a pfor runs on
+    .defineFunction("parallel_threads")
+    .returns(createTypeInfo("int"))
+    .withParams()
+    .done()
+    // parallel_set_threads(n)
+    .defineFunction("parallel_set_threads")
+    .returns(createTypeInfo("void"))
+    .withParams("int")
+    .done()
+    // parallel_wtime(): monotonic wall-clock seconds
+    .defineFunction("parallel_wtime")
+    .returns(createTypeInfo("double"))
+    .withParams()
+    .done()
+    .defineFlags("-pthread")
+    // Build
+    .build();
+}
+
+// Views are built and measured inline; the IR generator never calls out.
+export const SLICE_FUNCTIONS = new Set(["slice", "slice_len"]);
+
+// Fat strings (`str`): str_len and cstr are emitted inline; the others are
+// C functions that write their result through a pointer.
+export const FAT_STRING_FUNCTIONS = new Set([
+  "str_len",
+  "cstr",
+  "str_from",
+  "str_cat",
+]);
+
+// SIMD operations map straight onto vector instructions and are emitted
+// inline by the IR generator; the module has no C source.
+export const SIMD_FUNCTIONS = new Set([
+  "shuffle",
+  "with_lane",
+  "reduce_add",
+  "reduce_mul",
+  "reduce_min",
+  "reduce_max",
+  ...Object.keys(SimdTypes).flatMap((type) => [
+    `${type}_splat`,
+    `${type}_load`,
+    `${type}_store`,
+  ]),
+]);
+
+function createSimdModule(): StdLibModule {
+  const module = defineModule("simd").defineIROnly();
+
+  for (const type of Object.keys(SimdTypes)) {
+    module
+      // f32x4_splat(x)
+      .defineFunction(`${type}_splat`)
+      .returns(createTypeInfo(type))
+      .withParams("double")
+      .done()
+      // f32x4_load(array, index)
+      .defineFunction(`${type}_load`)
+      .returns(createTypeInfo(type))
+      .withParams("id", "i64")
+      .done()
+      // f32x4_store(array, index, value)
+      .defineFunction(`${type}_store`)
+      .returns(createTypeInfo("void"))
+      .withParams("id", "i64", "id")
+      .done();
+  }
+
+  return module
+    // shuffle(a, b, [lanes])
+    .defineFunction("shuffle")
+    .returns(createTypeInfo("id"))
+    .withParams("id", "id", "id")
+    .done()
+    // with_lane(v, lane, x)
+    .defineFunction("with_lane")
+    .returns(createTypeInfo("id"))
+    .withParams("id", "i64", "double")
+    .done()
+    // reduce_add(v)
+    .defineFunction("reduce_add")
+    .returns(createTypeInfo("double"))
+    .withParams("id")
+    .done()
+    // reduce_mul(v)
+    .defineFunction("reduce_mul")
+    .returns(createTypeInfo("double"))
+    .withParams("id")
+    .done()
+    // reduce_min(v)
+    .defineFunction("reduce_min")
+    .returns(createTypeInfo("double"))
+    .withParams("id")
+    .done()
+    // reduce_max(v)
+    .defineFunction("reduce_max")
+    .returns(createTypeInfo("double"))
+    .withParams("id")
+    .done()
     // Build
     .build();
 }
@@ -261,11 +962,18 @@ export class StandardLibrary {
 
   private initializeModules(): void {
     this.registerModule(createIOModule());
+    this.registerModule(createFileModule());
     this.registerModule(createMathModule());
     this.registerModule(createStringModule());
     this.registerModule(createTypesModule());
     this.registerModule(createStringModule());
     this.registerModule(createMemoryModule());
+    this.registerModule(createArenaModule());
+    this.registerModule(createPoolModule());
+    this.registerModule(createVecModule());
+    this.registerModule(createSimdModule());
+    this.registerModule(createParallelModule());
+    this.registerModule(createAtomicModule());
     this.registerModule(createCppModule());
   }
 }
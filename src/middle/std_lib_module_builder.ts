@@ -33,6 +33,7 @@ export interface StdLibModule {
   name: string;
   functions: Map<string, StdLibFunction>;
   flags?: string[];
+  irOnly?: boolean; // Every function is defined in IR, there is no C source
 }
 
 export class StdLibModuleBuilder {
@@ -54,6 +55,11 @@ export class StdLibModuleBuilder {
     return this;
   }
 
+  defineIROnly(): StdLibModuleBuilder {
+    this.module.irOnly = true;
+    return this;
+  }
+
   addCompleteFunction(func: StdLibFunction): void {
     this.module.functions.set(func.name, func);
   }
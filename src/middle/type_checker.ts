@@ -14,7 +14,7 @@ import {
   LLVMType,
   TypeInfo,
 } from "../frontend/parser/ast.ts";
-import { TypesNative } from "../frontend/values.ts";
+import { AtomicTypes, SimdTypes, TypesNative } from "../frontend/values.ts";
 import { Semantic } from "./semantic.ts";
 
 export class TypeChecker {
@@ -50,6 +50,8 @@ export class TypeChecker {
     this.typeMap.set("float", LLVMType.DOUBLE);
     this.typeMap.set("double", LLVMType.DOUBLE);
     this.typeMap.set("string", LLVMType.STRING);
+    // Fat string: { data, length, inline bytes }, see stdlib/string.c
+    this.typeMap.set("str", "%farpy.str" as LLVMType);
     this.typeMap.set("bool", LLVMType.I1);
     this.typeMap.set("binary", LLVMType.I32);
     this.typeMap.set("null", LLVMType.PTR);
@@ -61,6 +63,14 @@ export class TypeChecker {
     // C | const char *
     this.typeMap.set("const char", LLVMType.STRING);
     this.typeMap.set("char", LLVMType.STRING);
+    // SIMD | f32x4 -> <4 x float>
+    for (const [name, { lanes, element }] of Object.entries(SimdTypes)) {
+      this.typeMap.set(name, `<${lanes} x ${element}>` as LLVMType);
+    }
+    // Atomics | atomic<int> -> i32, accessed with load/store atomic
+    for (const [name, { llvm }] of Object.entries(AtomicTypes)) {
+      this.typeMap.set(name, llvm as LLVMType);
+    }
   }
 
   public isValidType(type: string | LLVMType | TypesNative): boolean {
@@ -81,6 +91,25 @@ export class TypeChecker {
     return llvmType;
   }
 
+  // Vectors are monomorphized: one `{ T*, i64, i64 }` struct per element
+  // type, e.g. `%farpy.vec.i32` or `%farpy.vec.i8p` for strings.
+  public mapToLLVMVectorType(elementType: TypesNative | string): string {
+    const element = String(this.mapToLLVMType(elementType));
+    return `%farpy.vec.${element.replace(/^%/, "").replace(/\*/g, "p")}`;
+  }
+
+  // Views are `{ T*, i64 }` values; a string view points at its bytes.
+  public mapToLLVMSliceType(baseType: TypesNative | string): string {
+    const element = this.sliceElementType(baseType);
+    return `%farpy.slice.${element.replace(/^%/, "").replace(/\*/g, "p")}`;
+  }
+
+  public sliceElementType(baseType: TypesNative | string): string {
+    return baseType === "string"
+      ? "i8"
+      : String(this.mapToLLVMType(baseType));
+  }
+
   public getLLVMTypeString(type: LLVMType | string): string {
     switch (type) {
       case LLVMType.I1:
@@ -117,6 +146,35 @@ export class TypeChecker {
     return numericTypes.includes(String(type));
   }
 
+  public isSimdType(type: TypesNative | string): boolean {
+    return Object.hasOwn(SimdTypes, String(type));
+  }
+
+  // Farpy type of a single lane: f32 lanes read back as float (double)
+  public simdLaneType(type: TypesNative | string): TypesNative {
+    const { element } = SimdTypes[String(type)];
+    if (element === "i32") return "int";
+    if (element === "i64") return "i64";
+    return "double";
+  }
+
+  public isAtomicType(type: TypesNative | string): boolean {
+    return Object.hasOwn(AtomicTypes, String(type));
+  }
+
+  // Types with a size LLVM can fold: every native but void, and structs
+  public isSizedType(type: TypesNative | string): boolean {
+    if (type === "void") return false;
+    return this.typeMap.has(type) ||
+      Boolean(this.semantic?.structs.has(String(type)));
+  }
+
+  public simdTypeFor(element: string, lanes: number): string | undefined {
+    return Object.keys(SimdTypes).find((name) =>
+      SimdTypes[name].element === element && SimdTypes[name].lanes === lanes
+    );
+  }
+
   public isFloat(
     left: TypesNative | string,
     right: TypesNative | string,
@@ -163,7 +221,7 @@ export class TypeChecker {
       "binary": ["int", "i32", "i64", "long"],
       "i64": ["float", "double", "bool"],
       "long": ["float", "double", "bool"],
-      "string": ["const char", "char", "binary"],
+      "string": ["const char", "char", "binary", "str"],
       "bool": ["int", "i32", "long", "float", "double", "string", "i64"],
     };
 
@@ -181,6 +239,10 @@ export class TypeChecker {
     const leftType: TypesNative | string = left.type.baseType;
     const rightType: TypesNative | string = right.type.baseType;
 
+    if (this.isSimdType(leftType) || this.isSimdType(rightType)) {
+      return this.checkSimdBinaryExprTypes(left, right, operator);
+    }
+
     // Check compatibility between types
     if (
       leftType !== rightType && !this.areTypesCompatible(leftType, rightType)
@@ -328,6 +390,45 @@ export class TypeChecker {
     }
   }
 
+  // Lane-wise arithmetic: both sides of the same SIMD type, or one SIMD
+  // value and a numeric scalar that is broadcast to every lane.
+  private checkSimdBinaryExprTypes(
+    left: Expr,
+    right: Expr,
+    operator: string,
+  ): TypeInfo {
+    const leftType = String(left.type.baseType);
+    const rightType = String(right.type.baseType);
+    const simdType = this.isSimdType(leftType) ? leftType : rightType;
+    const other = simdType === leftType ? rightType : leftType;
+
+    if (!["+", "-", "*", "/"].includes(operator)) {
+      this.reporter!.addError(
+        this.makeLoc(left.loc, right.loc),
+        `Operator '${operator}' cannot be applied to SIMD type '${simdType}'`,
+      );
+      throw new Error(
+        `Operator '${operator}' cannot be applied to SIMD type '${simdType}'`,
+      );
+    }
+
+    if (
+      other !== simdType &&
+      (this.isSimdType(other) || !this.isNumericType(other) ||
+        left.type.isArray || right.type.isArray)
+    ) {
+      this.reporter!.addError(
+        this.makeLoc(left.loc, right.loc),
+        `Operator '${operator}' cannot be applied to types '${leftType}' and '${rightType}'`,
+      );
+      throw new Error(
+        `Operator '${operator}' cannot be applied to types '${leftType}' and '${rightType}'`,
+      );
+    }
+
+    return createTypeInfo(simdType as TypesNative);
+  }
+
   public registerCustomType(sourceType: string, llvmType: LLVMType): void {
     this.typeMap.set(sourceType, llvmType);
   }
@@ -6,7 +6,7 @@
  * This software is licensed under the MIT License.
  * See the LICENSE file in the project root for full license information.
  */
-import { IRValue } from "../types/IRTypes.ts";
+import { AtomicOrdering, IRValue } from "../types/IRTypes.ts";
 import { LLVMFunction } from "./LLVMFunction.ts";
 
 export class LLVMBasicBlock {
@@ -15,6 +15,10 @@ export class LLVMBasicBlock {
   constructor(public label: string, private tempCounter: LLVMFunction) {}
 
   public add(instruction: string): void {
+    const location = this.tempCounter.debugLocation;
+    if (location && !instruction.startsWith(";")) {
+      instruction += `, !dbg ${location}`;
+    }
     this.instructions.push(`  ${instruction}`);
   }
 
@@ -30,6 +34,11 @@ export class LLVMBasicBlock {
     return type === "float" || type === "double";
   }
 
+  // Lane type of a `<N x T>` SIMD vector, or the type itself
+  private scalarOf(type: string): string {
+    return type.match(/^<\d+ x (\w+)>$/)?.[1] ?? type;
+  }
+
   private getIntRank(type: string): number {
     const bits = parseInt(type.slice(1), 10);
     return isNaN(bits) ? 0 : bits;
@@ -338,14 +347,25 @@ export class LLVMBasicBlock {
           return 8;
         }
 
-        // For array types, parse dimensions and calculate alignment
+        // SIMD vectors are aligned to their full width (<4 x float> -> 16)
+        const vector = baseType.match(/^<(\d+) x (\w+)>$/);
+        if (vector) {
+          return Number(vector[1]) * this.getAlign(vector[2]);
+        }
+
+        // For array types, parse dimensions and calculate alignment.
+        // Arrays of 16 bytes or more are aligned to 16 (32 from 32 bytes
+        // up), like clang does on x86-64, so SIMD loads from them can be.
         if (baseType.includes("[") && baseType.includes("x")) {
           // Extract the element type (e.g., for [4 x i32], get i32)
-          const elementType = baseType.substring(
-            baseType.lastIndexOf("x") + 2,
-          )
-            .trim().replace("]", "");
-          return this.getAlign(elementType);
+          const elementType = baseType.replace(/\[\d+ x /g, "")
+            .replace(/\]/g, "").trim();
+          const elementAlign = this.getAlign(elementType);
+          const size = [...baseType.matchAll(/\[(\d+) x /g)]
+            .reduce((total, match) => total * Number(match[1]), elementAlign);
+          if (size >= 32) return Math.max(elementAlign, 32);
+          if (size >= 16) return Math.max(elementAlign, 16);
+          return elementAlign;
         }
 
         console.warn(`Unknown type for alignment: ${type}, defaulting to 8`);
@@ -356,7 +376,7 @@ export class LLVMBasicBlock {
   public addInst(op1: IRValue, op2: IRValue): IRValue {
     const { op1: lhs, op2: rhs, commonType } = this.convertOperands(op1, op2);
     const tmp = this.nextTemp();
-    const instr = this.isFloat(commonType) ? "fadd" : "add";
+    const instr = this.isFloat(this.scalarOf(commonType)) ? "fadd" : "add";
     this.add(`${tmp} = ${instr} ${commonType} ${lhs.value}, ${rhs.value}`);
     return { value: tmp, type: commonType };
   }
@@ -364,7 +384,7 @@ export class LLVMBasicBlock {
   public subInst(op1: IRValue, op2: IRValue): IRValue {
     const { op1: lhs, op2: rhs, commonType } = this.convertOperands(op1, op2);
     const tmp = this.nextTemp();
-    const instr = this.isFloat(commonType) ? "fsub" : "sub";
+    const instr = this.isFloat(this.scalarOf(commonType)) ? "fsub" : "sub";
     this.add(`${tmp} = ${instr} ${commonType} ${lhs.value}, ${rhs.value}`);
     return { value: tmp, type: commonType };
   }
@@ -372,7 +392,7 @@ export class LLVMBasicBlock {
   public mulInst(op1: IRValue, op2: IRValue): IRValue {
     const { op1: lhs, op2: rhs, commonType } = this.convertOperands(op1, op2);
     const tmp = this.nextTemp();
-    const instr = this.isFloat(commonType) ? "fmul" : "mul";
+    const instr = this.isFloat(this.scalarOf(commonType)) ? "fmul" : "mul";
     this.add(`${tmp} = ${instr} ${commonType} ${lhs.value}, ${rhs.value}`);
     return { value: tmp, type: commonType };
   }
@@ -380,7 +400,7 @@ export class LLVMBasicBlock {
   public divInst(op1: IRValue, op2: IRValue): IRValue {
     const { op1: lhs, op2: rhs, commonType } = this.convertOperands(op1, op2);
     const tmp = this.nextTemp();
-    const instr = this.isFloat(commonType) ? "fdiv" : "sdiv";
+    const instr = this.isFloat(this.scalarOf(commonType)) ? "fdiv" : "sdiv";
     this.add(`${tmp} = ${instr} ${commonType} ${lhs.value}, ${rhs.value}`);
     return { value: tmp, type: commonType };
   }
@@ -402,7 +422,7 @@ export class LLVMBasicBlock {
     };
   }
 
-  public loadInst(ptr: IRValue): IRValue {
+  public loadInst(ptr: IRValue, align?: number): IRValue {
     if (!ptr.type.endsWith("*") && ptr.type != "ptr") {
       throw new Error(`Erro: Tentativa de load em não-ponteiro (${ptr.type})`);
     }
@@ -412,13 +432,13 @@ export class LLVMBasicBlock {
 
     this.add(
       `${tmp} = load ${base}, ${ptrTypeInInst} ${ptr.value}, align ${
-        this.getAlign(base)
+        align ?? this.getAlign(base)
       }`,
     );
     return { value: tmp, type: base };
   }
 
-  public storeInst(value: IRValue, ptr: IRValue): void {
+  public storeInst(value: IRValue, ptr: IRValue, align?: number): void {
     if (!ptr.type.endsWith("*") && ptr.type != "ptr") {
       throw new Error(`Erro store: alvo não é ponteiro`);
     }
@@ -430,9 +450,76 @@ export class LLVMBasicBlock {
     }
     this.add(
       `store ${value.type} ${value.value}, ${ptrTypeInInst} ${ptr.value}, align ${
+        align ?? this.getAlign(base)
+      }`,
+    );
+  }
+
+  // Atomic accesses must be aligned to their full size, so the natural
+  // alignment is always spelled out.
+  public atomicLoadInst(ptr: IRValue, ordering: AtomicOrdering): IRValue {
+    const base = ptr.type != "ptr" ? ptr.type.slice(0, -1) : ptr.type;
+    const tmp = this.nextTemp();
+    this.add(
+      `${tmp} = load atomic ${base}, ${ptr.type} ${ptr.value} ${ordering}, align ${
         this.getAlign(base)
       }`,
     );
+    return { value: tmp, type: base };
+  }
+
+  public atomicStoreInst(
+    value: IRValue,
+    ptr: IRValue,
+    ordering: AtomicOrdering,
+  ): void {
+    this.add(
+      `store atomic ${value.type} ${value.value}, ${ptr.type} ${ptr.value} ${ordering}, align ${
+        this.getAlign(value.type)
+      }`,
+    );
+  }
+
+  // Returns the value `ptr` held before the operation
+  public atomicRMWInst(
+    operation: "xchg" | "add" | "sub",
+    ptr: IRValue,
+    value: IRValue,
+    ordering: AtomicOrdering,
+  ): IRValue {
+    const tmp = this.nextTemp();
+    this.add(
+      `${tmp} = atomicrmw ${operation} ${ptr.type} ${ptr.value}, ${value.type} ${value.value} ${ordering}`,
+    );
+    return { value: tmp, type: value.type };
+  }
+
+  // Strong compare-and-swap; returns whether `desired` was stored. The
+  // failure ordering is the strongest one LLVM allows for `success`.
+  public cmpXchgInst(
+    ptr: IRValue,
+    expected: IRValue,
+    desired: IRValue,
+    ordering: AtomicOrdering,
+  ): IRValue {
+    const failure = ordering == "acq_rel"
+      ? "acquire"
+      : ordering == "release"
+      ? "monotonic"
+      : ordering;
+    const pair = this.nextTemp();
+    this.add(
+      `${pair} = cmpxchg ${ptr.type} ${ptr.value}, ${expected.type} ${expected.value}, ${desired.type} ${desired.value} ${ordering} ${failure}`,
+    );
+    return this.extractValueInst(
+      { value: pair, type: `{ ${expected.type}, i1 }` },
+      1,
+      "i1",
+    );
+  }
+
+  public fenceInst(ordering: AtomicOrdering): void {
+    this.add(`fence ${ordering}`);
   }
 
   public getElementPtr(arrayType: string, globalLabel: string): IRValue {
@@ -468,6 +555,36 @@ export class LLVMBasicBlock {
     return { value: tmp, type: commonType };
   }
 
+  public andInst(left: IRValue, right: IRValue): IRValue {
+    const { op1: lhs, op2: rhs, commonType } = this.convertOperands(
+      left,
+      right,
+    );
+    if (!this.isInteger(commonType)) {
+      throw new Error(`Erro and: tipo não é inteiro (${commonType})`);
+    }
+    const tmp = this.nextTemp();
+    this.add(`${tmp} = and ${commonType} ${lhs.value}, ${rhs.value}`);
+    return { value: tmp, type: commonType };
+  }
+
+  public selectInst(
+    condition: IRValue,
+    ifTrue: IRValue,
+    ifFalse: IRValue,
+  ): IRValue {
+    if (condition.type !== "i1" || ifTrue.type !== ifFalse.type) {
+      throw new Error(
+        `Erro select: tipos incompatíveis ${ifTrue.type} vs ${ifFalse.type}`,
+      );
+    }
+    const tmp = this.nextTemp();
+    this.add(
+      `${tmp} = select i1 ${condition.value}, ${ifTrue.type} ${ifTrue.value}, ${ifFalse.type} ${ifFalse.value}`,
+    );
+    return { value: tmp, type: ifTrue.type };
+  }
+
   public fcmpInst(
     predicate:
       | "oeq"
@@ -540,13 +657,16 @@ export class LLVMBasicBlock {
     funcName: string,
     args: IRValue[],
     argTypes: string[],
+    tail: "" | "tail" | "musttail" = "",
+    calleeType: string = retType,
   ): IRValue {
     const tmp = this.nextTemp();
     const argsStr = args.map((a, i) => `${argTypes[i]} ${a.value}`).join(", ");
+    const call = tail ? `${tail} call` : "call";
     if (retType != "void") {
-      this.add(`${tmp} = call ${retType} @${funcName}(${argsStr})`);
+      this.add(`${tmp} = ${call} ${calleeType} @${funcName}(${argsStr})`);
     } else {
-      this.add(`call ${retType} @${funcName}(${argsStr})`);
+      this.add(`${call} ${calleeType} @${funcName}(${argsStr})`);
     }
     return { value: tmp, type: retType };
   }
@@ -566,6 +686,13 @@ export class LLVMBasicBlock {
     op1: IRValue,
     op2: IRValue,
   ): IRValue {
+    // Integers of different widths are compared at the wider one
+    if (
+      op1.type !== op2.type && this.isInteger(op1.type) &&
+      this.isInteger(op2.type)
+    ) {
+      ({ op1, op2 } = this.convertOperands(op1, op2));
+    }
     if (op1.type !== op2.type) {
       throw new Error(
         `Erro icmp: tipos incompatíveis ${op1.type} vs ${op2.type}`,
@@ -594,6 +721,15 @@ export class LLVMBasicBlock {
     this.add(`br label %${label}`);
   }
 
+  public phiInst(type: string, incoming: [string, string][]): IRValue {
+    const tmp = this.nextTemp();
+    const pairs = incoming
+      .map(([value, label]) => `[ ${value}, %${label} ]`)
+      .join(", ");
+    this.add(`${tmp} = phi ${type} ${pairs}`);
+    return { value: tmp, type };
+  }
+
   public toString(): string {
     return `${this.label}:\n${this.instructions.join("\n")}`;
   }
@@ -605,6 +741,23 @@ export class LLVMBasicBlock {
     return { value: tmp, type: `${arrayType}*` };
   }
 
+  // Needs `declare void @llvm.memcpy.p0i8.p0i8.i64(i8*, i8*, i64, i1)`
+  public memcpyInst(dest: IRValue, src: IRValue): void {
+    const type = dest.type.slice(0, -1);
+    const destPtr = this.convertValueToType(dest, "i8*");
+    const srcPtr = this.convertValueToType(src, "i8*");
+    const size =
+      `ptrtoint (${type}* getelementptr (${type}, ${type}* null, i32 1) to i64)`;
+
+    this.add(
+      `call void @llvm.memcpy.p0i8.p0i8.i64(i8* align ${
+        this.getAlign(type)
+      } ${destPtr.value}, i8* align ${
+        this.getAlign(type)
+      } ${srcPtr.value}, i64 ${size}, i1 false)`,
+    );
+  }
+
   public createGlobalArray(
     name: string,
     elementType: string,
@@ -623,7 +776,14 @@ export class LLVMBasicBlock {
     }
   }
 
-  public getStringElementPtr(stringPtr: IRValue, index: IRValue): IRValue {
+  // `s[i]` is a one-character string. Rather than building it in a fresh
+  // stack buffer per access, point into `charTable`, a constant
+  // `[256 x [2 x i8]]` holding every byte followed by a NUL.
+  public getStringElementPtr(
+    stringPtr: IRValue,
+    index: IRValue,
+    charTable: string,
+  ): IRValue {
     if (!stringPtr.type.endsWith("*")) {
       throw new Error(
         `getStringElementPtr requires a pointer to a string (i8*), got ${stringPtr.type}`,
@@ -644,23 +804,110 @@ export class LLVMBasicBlock {
     const charTmp = this.nextTemp();
     this.add(`${charTmp} = load i8, i8* ${tmp}, align 1`);
 
-    const resultPtr = this.nextTemp();
-    this.add(`${resultPtr} = alloca [2 x i8], align 1`);
+    const charIndex = this.nextTemp();
+    this.add(`${charIndex} = zext i8 ${charTmp} to i64`);
 
-    const firstCharPtr = this.nextTemp();
+    const charPtr = this.nextTemp();
     this.add(
-      `${firstCharPtr} = getelementptr inbounds [2 x i8], [2 x i8]* ${resultPtr}, i32 0, i32 0`,
+      `${charPtr} = getelementptr inbounds [256 x [2 x i8]], [256 x [2 x i8]]* ${charTable}, i64 0, i64 ${charIndex}, i64 0`,
     );
 
-    this.add(`store i8 ${charTmp}, i8* ${firstCharPtr}, align 1`);
+    return { value: charPtr, type: "i8*" };
+  }
+
+  public extractValueInst(
+    aggregate: IRValue,
+    index: number,
+    type: string,
+  ): IRValue {
+    const tmp = this.nextTemp();
+    this.add(
+      `${tmp} = extractvalue ${aggregate.type} ${aggregate.value}, ${index}`,
+    );
+    return { value: tmp, type };
+  }
 
-    const nullTermPtr = this.nextTemp();
+  public extractElementInst(vector: IRValue, index: IRValue): IRValue {
+    const tmp = this.nextTemp();
     this.add(
-      `${nullTermPtr} = getelementptr inbounds i8, i8* ${firstCharPtr}, i32 1`,
+      `${tmp} = extractelement ${vector.type} ${vector.value}, ${index.type} ${index.value}`,
     );
-    this.add(`store i8 0, i8* ${nullTermPtr}, align 1`);
+    return { value: tmp, type: this.scalarOf(vector.type) };
+  }
 
-    return { value: firstCharPtr, type: "i8*" };
+  public insertElementInst(
+    vector: IRValue,
+    value: IRValue,
+    index: IRValue,
+  ): IRValue {
+    const tmp = this.nextTemp();
+    this.add(
+      `${tmp} = insertelement ${vector.type} ${vector.value}, ${value.type} ${value.value}, ${index.type} ${index.value}`,
+    );
+    return { value: tmp, type: vector.type };
+  }
+
+  // Lanes of `left ++ right` picked by a constant mask
+  public shuffleVectorInst(
+    left: IRValue,
+    right: IRValue,
+    mask: number[],
+  ): IRValue {
+    const maskType = `<${mask.length} x i32>`;
+    const lanes = mask.map((lane) => `i32 ${lane}`).join(", ");
+    const tmp = this.nextTemp();
+    this.add(
+      `${tmp} = shufflevector ${left.type} ${left.value}, ${right.type} ${right.value}, ${maskType} <${lanes}>`,
+    );
+    return {
+      value: tmp,
+      type: `<${mask.length} x ${this.scalarOf(left.type)}>`,
+    };
+  }
+
+  // Lane-wise float <-> double or integer width change
+  public convertVectorInst(vector: IRValue, targetType: string): IRValue {
+    if (vector.type === targetType) return vector;
+
+    const from = this.scalarOf(vector.type);
+    const to = this.scalarOf(targetType);
+    const instr = this.isFloat(from)
+      ? this.getFloatRank(from) < this.getFloatRank(to) ? "fpext" : "fptrunc"
+      : this.getIntRank(from) < this.getIntRank(to)
+      ? "sext"
+      : "trunc";
+    const tmp = this.nextTemp();
+    this.add(
+      `${tmp} = ${instr} ${vector.type} ${vector.value} to ${targetType}`,
+    );
+    return { value: tmp, type: targetType };
+  }
+
+  // Broadcast a scalar (already of the lane type) to every lane
+  public splatInst(value: IRValue, vectorType: string): IRValue {
+    const lanes = Number(vectorType.match(/^<(\d+) x /)![1]);
+    const first = this.insertElementInst(
+      { value: "undef", type: vectorType },
+      value,
+      { value: "0", type: "i32" },
+    );
+    const tmp = this.nextTemp();
+    this.add(
+      `${tmp} = shufflevector ${vectorType} ${first.value}, ${vectorType} undef, <${lanes} x i32> zeroinitializer`,
+    );
+    return { value: tmp, type: vectorType };
+  }
+
+  public insertValueInst(
+    aggregate: IRValue,
+    value: IRValue,
+    index: number,
+  ): IRValue {
+    const tmp = this.nextTemp();
+    this.add(
+      `${tmp} = insertvalue ${aggregate.type} ${aggregate.value}, ${value.type} ${value.value}, ${index}`,
+    );
+    return { value: tmp, type: aggregate.type };
   }
 
   public getArrayElementPtr(arrayPtr: IRValue, index: IRValue): IRValue {
@@ -692,6 +939,21 @@ export class LLVMBasicBlock {
     return { value: tmp, type: `${elementType}*` };
   }
 
+  // Element of a heap buffer (`T*`), indexed with i64
+  public getPointerElementPtr(dataPtr: IRValue, index: IRValue): IRValue {
+    const elementType = dataPtr.type.slice(0, -1);
+    const indexValue = index.type !== "i64"
+      ? this.convertValueToType(index, "i64")
+      : index;
+    const tmp = this.nextTemp();
+
+    this.add(
+      `${tmp} = getelementptr inbounds ${elementType}, ${dataPtr.type} ${dataPtr.value}, i64 ${indexValue.value}`,
+    );
+
+    return { value: tmp, type: dataPtr.type };
+  }
+
   public setArrayElement(
     arrayPtr: IRValue,
     index: IRValue,
@@ -0,0 +1,82 @@
+/**
+ * Farpy - A programming language
+ *
+ * Copyright (c) 2025 Fernando (FernandoTheDev)
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file in the project root for full license information.
+ */
+import { LLVMModule } from "./LLVMModule.ts";
+
+// Line-table level DWARF metadata: one compile unit, a subprogram per
+// function and a (cached) DILocation per line/column/scope.
+export class LLVMDebugInfo {
+  private readonly file: string;
+  private readonly compileUnit: string;
+  private readonly subroutineType: string;
+  private locations: Map<string, string> = new Map();
+
+  constructor(
+    private module: LLVMModule,
+    filename: string,
+    directory: string,
+    producer: string,
+  ) {
+    this.file = this.module.nextMetadataId();
+    this.module.addMetadata(
+      this.file,
+      `!DIFile(filename: "${filename}", directory: "${directory}")`,
+    );
+
+    this.compileUnit = this.module.nextMetadataId();
+    this.module.addMetadata(
+      this.compileUnit,
+      `distinct !DICompileUnit(language: DW_LANG_C, file: ${this.file}, producer: "${producer}", isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug)`,
+    );
+
+    this.subroutineType = this.module.nextMetadataId();
+    this.module.addMetadata(
+      this.subroutineType,
+      `!DISubroutineType(types: !{null})`,
+    );
+
+    const dwarfVersion = this.module.nextMetadataId();
+    this.module.addMetadata(dwarfVersion, `!{i32 7, !"Dwarf Version", i32 4}`);
+    const debugInfoVersion = this.module.nextMetadataId();
+    this.module.addMetadata(
+      debugInfoVersion,
+      `!{i32 2, !"Debug Info Version", i32 3}`,
+    );
+
+    this.module.addMetadata("!llvm.dbg.cu", `!{${this.compileUnit}}`);
+    this.module.addMetadata(
+      "!llvm.module.flags",
+      `!{${dwarfVersion}, ${debugInfoVersion}}`,
+    );
+  }
+
+  public createSubprogram(name: string, line: number): string {
+    const id = this.module.nextMetadataId();
+    this.module.addMetadata(
+      id,
+      `distinct !DISubprogram(name: "${name}", scope: ${this.file}, file: ${this.file}, line: ${line}, type: ${this.subroutineType}, scopeLine: ${line}, spFlags: DISPFlagDefinition, unit: ${this.compileUnit})`,
+    );
+    return id;
+  }
+
+  public getLocation(line: number, column: number, scope: string): string {
+    const key = `${line}:${column}:${scope}`;
+    let id = this.locations.get(key);
+
+    if (!id) {
+      id = this.module.nextMetadataId();
+      this.module.addMetadata(
+        id,
+        `!DILocation(line: ${line}, column: ${column}, scope: ${scope})`,
+      );
+      this.locations.set(key, id);
+    }
+
+    return id;
+  }
+}
@@ -6,6 +6,7 @@
  * This software is licensed under the MIT License.
  * See the LICENSE file in the project root for full license information.
  */
+import { IRValue } from "../types/IRTypes.ts";
 import { LLVMBasicBlock } from "./LLVMBasicBlock.ts";
 import { TempCounter } from "./TempCounter.ts";
 
@@ -14,6 +15,9 @@ export class LLVMFunction {
   public tempCounter: TempCounter = new TempCounter();
   public blockCounter: number = 0;
   public currentBlock: LLVMBasicBlock | null = null;
+  public attributes: string[] = [];
+  public debugScope: string | null = null; // !DISubprogram
+  public debugLocation: string | null = null; // Attached to new instructions
 
   constructor(
     public name: string,
@@ -40,6 +44,20 @@ export class LLVMFunction {
     return this.currentBlock;
   }
 
+  // Only allocas in the entry block are promoted to registers by mem2reg,
+  // so loop-local slots are hoisted there instead of the current block.
+  public allocaInEntry(varType: string = "i32"): IRValue {
+    const entry = this.basicBlocks[0] ?? this.getCurrentBasicBlock();
+    const tmp = this.nextTemp();
+    entry.instructions.unshift(
+      `  ${tmp} = alloca ${varType}, align ${entry.getAlign(varType)}`,
+    );
+    return {
+      value: tmp,
+      type: varType == "ptr" ? `${varType}` : `${varType}*`,
+    };
+  }
+
   public createBasicBlock(label?: string): LLVMBasicBlock {
     const bb = new LLVMBasicBlock(
       label || `${this.name}_entry`,
@@ -51,7 +69,10 @@ export class LLVMFunction {
 
   public toString(): string {
     const paramsStr = this.params.map((p) => `${p.type} %${p.name}`).join(", ");
-    const header = `define ${this.retType} @${this.name}(${paramsStr}) {`;
+    const attrs = this.attributes.map((attr) => ` ${attr}`).join("");
+    const dbg = this.debugScope ? ` !dbg ${this.debugScope}` : "";
+    const header =
+      `define ${this.retType} @${this.name}(${paramsStr})${attrs}${dbg} {`;
     const bbStr = this.basicBlocks.map((bb) => bb.toString()).join("\n");
     return `${header}\n${bbStr}\n}`;
   }
@@ -12,6 +12,8 @@ export class LLVMModule {
   public globals: string[] = [];
   public externals: string[] = [];
   public functions: LLVMFunction[] = [];
+  public metadata: string[] = [];
+  private metadataCounter: number = 0;
 
   constructor(public name: string = "module") {}
 
@@ -27,6 +29,14 @@ export class LLVMModule {
     this.functions.push(func);
   }
 
+  public nextMetadataId(): string {
+    return `!${this.metadataCounter++}`;
+  }
+
+  public addMetadata(id: string, node: string): void {
+    this.metadata.push(`${id} = ${node}`);
+  }
+
   public toString(): string {
     const extStr = this.externals.join("\n");
     const globalsStr = this.globals.join("\n");
@@ -48,6 +58,11 @@ export class LLVMModule {
       content += `${funcsStr}`;
     }
 
+    if (this.metadata.length > 0) {
+      content += `\n\n; Metadata\n`;
+      content += this.metadata.join("\n");
+    }
+
     return content;
   }
 }
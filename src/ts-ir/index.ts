@@ -9,6 +9,7 @@
 export * from "./core/LLVMModule.ts";
 export * from "./core/LLVMFunction.ts";
 export * from "./core/LLVMBasicBlock.ts";
+export * from "./core/LLVMDebugInfo.ts";
 export * from "./core/TempCounter.ts";
 export * from "./types/IRTypes.ts";
 export * from "./utils/Helpers.ts";
@@ -10,3 +10,11 @@ export interface IRValue {
   value: string;
   type: string; // Ex.: "i32", "i32*", etc.
 }
+
+// LLVM memory orderings; Farpy's `relaxed` is LLVM's `monotonic`
+export type AtomicOrdering =
+  | "monotonic"
+  | "acquire"
+  | "release"
+  | "acq_rel"
+  | "seq_cst";
@@ -12,6 +12,23 @@ export function createStringGlobal(
   module: LLVMModule,
   content: string,
 ): string {
+  const { escContent, byteLength } = escapeString(content);
+  const label = `@.str${module.globals.length}`;
+  const decl =
+    `${label} = private constant [${byteLength + 1} x i8] c"${escContent}\\00"`;
+
+  module.addGlobal(decl);
+  return label;
+}
+
+// Bytes in the global createStringGlobal emits, not counting the NUL
+export function stringByteLength(content: string): number {
+  return escapeString(content).byteLength;
+}
+
+function escapeString(
+  content: string,
+): { escContent: string; byteLength: number } {
   let escContent = "";
   let byteLength = 0;
 
@@ -40,11 +57,5 @@ export function createStringGlobal(
     }
   }
 
-  byteLength += 1;
-  const label = `@.str${module.globals.length}`;
-  const decl =
-    `${label} = private constant [${byteLength} x i8] c"${escContent}\\00"`;
-
-  module.addGlobal(decl);
-  return label;
+  return { escContent, byteLength };
 }
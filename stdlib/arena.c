@@ -0,0 +1,184 @@
+/**
+ * Farpy - A programming language
+ *
+ * Copyright (c) 2025 Fernando (FernandoTheDev)
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file in the project root for full license information.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Bump allocator. An arena is a chain of blocks; allocation moves an
+ * offset forward in the current block and spills into the next one.
+ * Blocks are never returned to malloc before arena_free, so rewinding the
+ * arena (reset, or the end of a `region`) is O(1): every block after
+ * the current one is treated as empty and cleared when it is reached.
+ */
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN 16
+
+typedef struct farpy_block
+{
+    struct farpy_block *next;
+    size_t size;
+    size_t used;
+    _Alignas(ARENA_ALIGN) unsigned char data[];
+} farpy_block;
+
+typedef struct
+{
+    farpy_block *head;
+    farpy_block *current;
+    size_t block_size;
+} farpy_arena;
+
+/* What a `region` restores when it ends; allocated in the arena itself */
+typedef struct
+{
+    farpy_arena *previous;
+    farpy_block *block;
+    size_t used;
+} farpy_region;
+
+/* Where string and I/O functions allocate; NULL means malloc */
+static _Thread_local farpy_arena *current_arena = NULL;
+/* Per-thread arena behind `region` blocks, created on first use */
+static _Thread_local farpy_arena *thread_arena = NULL;
+
+static farpy_block *new_block(size_t size)
+{
+    farpy_block *block = malloc(sizeof(farpy_block) + size);
+    if (block == NULL)
+    {
+        perror("arena: block allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+farpy_arena *arena_new(int64_t block_size)
+{
+    farpy_arena *arena = malloc(sizeof(farpy_arena));
+    if (arena == NULL)
+    {
+        perror("arena_new failed");
+        exit(EXIT_FAILURE);
+    }
+
+    arena->block_size = block_size > 0 ? (size_t)block_size : ARENA_BLOCK_SIZE;
+    arena->head = new_block(arena->block_size);
+    arena->current = arena->head;
+    return arena;
+}
+
+void *arena_alloc(farpy_arena *arena, int64_t size)
+{
+    size_t bytes = ((size_t)size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    farpy_block *block = arena->current;
+
+    while (block->size - block->used < bytes)
+    {
+        if (block->next == NULL)
+        {
+            size_t block_size = arena->block_size;
+            block->next = new_block(bytes > block_size ? bytes : block_size);
+        }
+
+        /* Blocks past the current one hold nothing live */
+        block = block->next;
+        block->used = 0;
+    }
+
+    arena->current = block;
+    void *result = block->data + block->used;
+    block->used += bytes;
+    return result;
+}
+
+void arena_reset(farpy_arena *arena)
+{
+    arena->current = arena->head;
+    arena->head->used = 0;
+}
+
+void arena_free(farpy_arena *arena)
+{
+    if (current_arena == arena)
+        current_arena = NULL;
+
+    farpy_block *block = arena->head;
+    while (block != NULL)
+    {
+        farpy_block *next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+/* Bytes handed out since the last reset */
+int64_t arena_used(farpy_arena *arena)
+{
+    int64_t used = 0;
+    for (farpy_block *block = arena->head; block != NULL; block = block->next)
+    {
+        used += (int64_t)block->used;
+        if (block == arena->current)
+            break;
+    }
+    return used;
+}
+
+/* Makes `arena` (or malloc, for null) the target of string and I/O
+ * allocations on this thread; returns the previous one. */
+farpy_arena *arena_use(farpy_arena *arena)
+{
+    farpy_arena *previous = current_arena;
+    current_arena = arena;
+    return previous;
+}
+
+/* Allocation hook for the other stdlib modules (declared weak there):
+ * NULL means no arena is current and the caller should use malloc. */
+void *arena_alloc_current(size_t size)
+{
+    if (current_arena == NULL)
+        return NULL;
+    return arena_alloc(current_arena, (int64_t)size);
+}
+
+/* `region { ... }`: the compiler brackets the block with these two calls,
+ * and with the end call before any `return` inside it. */
+void *farpy_region_begin(void)
+{
+    if (thread_arena == NULL)
+        thread_arena = arena_new(0);
+
+    farpy_block *block = thread_arena->current;
+    size_t used = block->used;
+
+    farpy_region *region = arena_alloc(thread_arena, sizeof(farpy_region));
+    region->previous = current_arena;
+    region->block = block;
+    region->used = used;
+
+    current_arena = thread_arena;
+    return region;
+}
+
+void farpy_region_end(void *mark)
+{
+    farpy_region *region = mark;
+
+    current_arena = region->previous;
+    thread_arena->current = region->block;
+    region->block->used = region->used;
+}
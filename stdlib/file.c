@@ -0,0 +1,177 @@
+/**
+ * Farpy - A programming language
+ *
+ * Copyright (c) 2025 Fernando (FernandoTheDev)
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file in the project root for full license information.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Files by descriptor. Every function works on the int returned by
+ * file_open, so the io module's writer_new, lines_new and scanner_new
+ * accept it as well. Failures print the reason and end the program, like
+ * the readers in io.c.
+ */
+
+/* Layout of a string[:] value */
+typedef struct
+{
+    const char *data;
+    int64_t len;
+} farpy_view;
+
+static void file_failed(const char *caller)
+{
+    perror(caller);
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * file_open(path, mode): "r" reads, "w" creates or truncates, "a" appends,
+ * and "r+" / "w+" also allow the other direction
+ */
+int file_open(const char *path, const char *mode)
+{
+    int flags;
+    if (strcmp(mode, "r") == 0)
+        flags = O_RDONLY;
+    else if (strcmp(mode, "w") == 0)
+        flags = O_WRONLY | O_CREAT | O_TRUNC;
+    else if (strcmp(mode, "a") == 0)
+        flags = O_WRONLY | O_CREAT | O_APPEND;
+    else if (strcmp(mode, "r+") == 0)
+        flags = O_RDWR;
+    else if (strcmp(mode, "w+") == 0)
+        flags = O_RDWR | O_CREAT | O_TRUNC;
+    else
+    {
+        fprintf(stderr, "file_open: unknown mode '%s'\n", mode);
+        exit(EXIT_FAILURE);
+    }
+
+    int fd = open(path, flags | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        fprintf(stderr, "file_open: %s: %s\n", path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    return fd;
+}
+
+void file_close(int fd)
+{
+    if (close(fd) != 0)
+        file_failed("file_close failed");
+}
+
+int64_t file_size(int fd)
+{
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        file_failed("file_size failed");
+    return (int64_t)st.st_size;
+}
+
+/*
+ * file_pread(fd, buffer, count, offset): reads up to count bytes at offset
+ * without moving the file position. Returns the bytes read, fewer only at
+ * the end of the file.
+ */
+int64_t file_pread(int fd, char *buffer, int64_t count, int64_t offset)
+{
+    int64_t done = 0;
+    while (done < count)
+    {
+        ssize_t got = pread(fd, buffer + done, (size_t)(count - done),
+                            (off_t)(offset + done));
+        if (got < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            file_failed("file_pread failed");
+        }
+        if (got == 0)
+            break;
+        done += got;
+    }
+    return done;
+}
+
+/* file_pwrite(fd, text, offset): writes all of text at offset */
+int64_t file_pwrite(int fd, const char *data, int64_t len, int64_t offset)
+{
+    int64_t done = 0;
+    while (done < len)
+    {
+        ssize_t put = pwrite(fd, data + done, (size_t)(len - done),
+                             (off_t)(offset + done));
+        if (put < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            file_failed("file_pwrite failed");
+        }
+        done += put;
+    }
+    return done;
+}
+
+/*
+ * file_map(fd) -> string[:]: the whole file, mapped read-only. Pages are
+ * read in on first touch, so only the parts that are used cost anything.
+ * The view stays valid after file_close, until file_unmap.
+ */
+void file_map(farpy_view *out, int fd)
+{
+    int64_t size = file_size(fd);
+    out->data = "";
+    out->len = 0;
+    if (size == 0)
+        return;
+
+    void *data = mmap(NULL, (size_t)size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        file_failed("file_map failed");
+    out->data = data;
+    out->len = size;
+}
+
+void file_unmap(const char *data, int64_t len)
+{
+    if (len > 0 && munmap((void *)data, (size_t)len) != 0)
+        file_failed("file_unmap failed");
+}
+
+/* madvise wants a page aligned start, and a slice of a map may not be */
+static void advise(const char *data, int64_t len, int advice)
+{
+    if (len <= 0)
+        return;
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)data & ~(page - 1);
+    uintptr_t end = (uintptr_t)data + (uintptr_t)len;
+    /* Only a hint: an error changes nothing the program can see */
+    madvise((void *)start, end - start, advice);
+}
+
+/* file_sequential(view): read ahead aggressively, drop pages once read */
+void file_sequential(const char *data, int64_t len)
+{
+    advise(data, len, MADV_SEQUENTIAL);
+}
+
+/* file_willneed(view): start reading these pages in now */
+void file_willneed(const char *data, int64_t len)
+{
+    advise(data, len, MADV_WILLNEED);
+}
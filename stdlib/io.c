@@ -6,13 +6,26 @@
  * This software is licensed under the MIT License.
  * See the LICENSE file in the project root for full license information.
  */
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "number.h"
+
+/* Defined by the arena module when it is imported; see arena.c */
+extern void *arena_alloc_current(size_t size) __attribute__((weak));
 
 void print(char *message)
 {
-    printf("%s", message);
+    fputs(message, stdout);
 }
 
 char *read_line()
@@ -51,5 +64,623 @@ char *read_line()
     }
 
     buffer[len] = '\0';
+
+    /* The line is grown with realloc, then moved into the current arena */
+    char *line = arena_alloc_current ? arena_alloc_current(len + 1) : NULL;
+    if (line != NULL)
+    {
+        memcpy(line, buffer, len + 1);
+        free(buffer);
+        return line;
+    }
     return buffer;
 }
+
+/*
+ * Buffered writer. Writes are copied into a user-space buffer with no
+ * stdio call, format string or lock, and the buffer goes out in one write
+ * when it fills up, on flush, or at exit. A writer belongs to one thread.
+ * Writers on fd 1 and 2 drain into stdout and stderr, so their text stays
+ * in order with printf; other descriptors are written directly.
+ */
+#define WRITER_DEFAULT_SIZE (64 * 1024)
+
+typedef struct farpy_writer
+{
+    struct farpy_writer *next; /* Writers flushed at exit */
+    FILE *stream;              /* NULL for plain descriptors */
+    int fd;
+    char *buffer;
+    size_t size;
+    size_t len;
+} farpy_writer;
+
+static atomic_flag writers_lock = ATOMIC_FLAG_INIT;
+static farpy_writer *writers = NULL;
+
+static void lock_writers(void)
+{
+    while (atomic_flag_test_and_set_explicit(&writers_lock,
+                                             memory_order_acquire))
+        ;
+}
+
+static void unlock_writers(void)
+{
+    atomic_flag_clear_explicit(&writers_lock, memory_order_release);
+}
+
+static void drain(farpy_writer *writer, const char *data, size_t len)
+{
+    if (writer->stream != NULL)
+    {
+        if (fwrite(data, 1, len, writer->stream) == len)
+            return;
+        perror("writer: write failed");
+        exit(EXIT_FAILURE);
+    }
+
+    while (len > 0)
+    {
+        ssize_t written = write(writer->fd, data, len);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("writer: write failed");
+            exit(EXIT_FAILURE);
+        }
+        data += written;
+        len -= (size_t)written;
+    }
+}
+
+static void drain_buffer(farpy_writer *writer)
+{
+    drain(writer, writer->buffer, writer->len);
+    writer->len = 0;
+}
+
+static void flush_writers_at_exit(void)
+{
+    for (farpy_writer *writer = writers; writer != NULL; writer = writer->next)
+        drain_buffer(writer);
+}
+
+/* writer_new(fd, size): 0 picks a 64 KB buffer */
+farpy_writer *writer_new(int fd, int64_t size)
+{
+    static atomic_flag registered = ATOMIC_FLAG_INIT;
+    size_t bytes = size > 0 ? (size_t)size : WRITER_DEFAULT_SIZE;
+    /* Numbers are formatted in place, so one must always fit */
+    if (bytes < NUMBER_TEXT_MAX)
+        bytes = NUMBER_TEXT_MAX;
+
+    farpy_writer *writer = malloc(sizeof(farpy_writer));
+    char *buffer = malloc(bytes);
+    if (writer == NULL || buffer == NULL)
+    {
+        perror("writer_new failed");
+        exit(EXIT_FAILURE);
+    }
+
+    writer->stream = fd == 1 ? stdout : fd == 2 ? stderr : NULL;
+    writer->fd = fd;
+    writer->buffer = buffer;
+    writer->size = bytes;
+    writer->len = 0;
+
+    if (!atomic_flag_test_and_set(&registered))
+        atexit(flush_writers_at_exit);
+
+    lock_writers();
+    writer->next = writers;
+    writers = writer;
+    unlock_writers();
+    return writer;
+}
+
+void write_str(farpy_writer *writer, const char *s, int64_t len)
+{
+    if ((size_t)len > writer->size - writer->len)
+    {
+        drain_buffer(writer);
+        /* Too big to be worth copying */
+        if ((size_t)len >= writer->size)
+        {
+            drain(writer, s, (size_t)len);
+            return;
+        }
+    }
+
+    memcpy(writer->buffer + writer->len, s, (size_t)len);
+    writer->len += (size_t)len;
+}
+
+void write_char(farpy_writer *writer, int c)
+{
+    if (writer->len == writer->size)
+        drain_buffer(writer);
+    writer->buffer[writer->len++] = (char)c;
+}
+
+void write_int(farpy_writer *writer, int64_t value)
+{
+    if (writer->size - writer->len < NUMBER_TEXT_MAX)
+        drain_buffer(writer);
+    writer->len += (size_t)number_format_i64(writer->buffer + writer->len,
+                                             value);
+}
+
+/* Shortest text that reads back as the same double, see number.h */
+void write_f64(farpy_writer *writer, double value)
+{
+    if (writer->size - writer->len < NUMBER_TEXT_MAX)
+        drain_buffer(writer);
+    writer->len += (size_t)number_format_f64(writer->buffer + writer->len,
+                                             value);
+}
+
+void writer_flush(farpy_writer *writer)
+{
+    drain_buffer(writer);
+    if (writer->stream != NULL)
+        fflush(writer->stream);
+}
+
+/* Flushes and releases the writer; the descriptor stays open */
+void writer_close(farpy_writer *writer)
+{
+    writer_flush(writer);
+
+    lock_writers();
+    farpy_writer **link = &writers;
+    while (*link != writer)
+        link = &(*link)->next;
+    *link = writer->next;
+    unlock_writers();
+
+    free(writer->buffer);
+    free(writer);
+}
+
+/*
+ * Bulk input. read_all, the line reader and the scanner bypass stdio: a
+ * regular file is mapped whole, anything else (pipes, terminals) is read
+ * with read(2) in large blocks. Lines and tokens are handed out as views
+ * into that memory, so nothing is copied per line. Do not mix them with
+ * read_line or scanf on the same descriptor, since stdio may already hold
+ * bytes they would miss.
+ */
+#define READ_BUFFER_SIZE (256 * 1024)
+
+/* Layout of a string[:] value */
+typedef struct
+{
+    const char *data;
+    int64_t len;
+} farpy_view;
+
+static ssize_t read_some(int fd, char *buffer, size_t len)
+{
+    for (;;)
+    {
+        ssize_t got = read(fd, buffer, len);
+        if (got >= 0)
+            return got;
+        if (errno != EINTR)
+        {
+            perror("read failed");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/*
+ * Maps the rest of a regular file, from the current offset to the end, and
+ * moves the offset past it. Returns false when fd is not a regular file or
+ * cannot be mapped, so the caller falls back to read(2).
+ */
+static bool map_rest(int fd, char **map, size_t *map_size, size_t *offset)
+{
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    off_t at = lseek(fd, 0, SEEK_CUR);
+    if (at < 0 || at > st.st_size)
+        return false;
+
+    *map = NULL;
+    *map_size = (size_t)st.st_size;
+    *offset = (size_t)at;
+    if (at == st.st_size)
+        return true;
+
+    void *data = mmap(NULL, *map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        return false;
+    madvise(data, *map_size, MADV_SEQUENTIAL);
+    lseek(fd, 0, SEEK_END);
+    *map = data;
+    return true;
+}
+
+/* read_all(): all of stdin as one view; the memory lives until exit */
+void read_all(farpy_view *out)
+{
+    char *map;
+    size_t map_size, offset;
+    if (map_rest(0, &map, &map_size, &offset))
+    {
+        out->data = map != NULL ? map + offset : "";
+        out->len = (int64_t)(map_size - offset);
+        return;
+    }
+
+    size_t size = READ_BUFFER_SIZE;
+    size_t len = 0;
+    char *buffer = malloc(size);
+    if (buffer == NULL)
+    {
+        perror("read_all failed");
+        exit(EXIT_FAILURE);
+    }
+
+    for (;;)
+    {
+        if (len == size)
+        {
+            size *= 2;
+            char *grown = realloc(buffer, size);
+            if (grown == NULL)
+            {
+                perror("read_all failed");
+                exit(EXIT_FAILURE);
+            }
+            buffer = grown;
+        }
+        ssize_t got = read_some(0, buffer + len, size - len);
+        if (got == 0)
+            break;
+        len += (size_t)got;
+    }
+
+    out->data = buffer;
+    out->len = (int64_t)len;
+}
+
+/* Shared by the line reader and the scanner */
+typedef struct
+{
+    int fd;
+    char *map;          /* Mapped file, or NULL */
+    size_t map_size;
+    char *buffer;       /* Read buffer when not mapped */
+    size_t size;
+    const char *data;   /* Unread bytes are data[pos..len) */
+    size_t pos;
+    size_t len;
+    size_t scanned;     /* Bytes after pos known to hold no newline */
+    bool eof;
+    const char *line;
+    int64_t line_len;
+} farpy_reader;
+
+static farpy_reader *reader_new(int fd)
+{
+    farpy_reader *reader = calloc(1, sizeof(farpy_reader));
+    if (reader == NULL)
+    {
+        perror("reader_new failed");
+        exit(EXIT_FAILURE);
+    }
+    reader->fd = fd;
+
+    size_t offset;
+    if (map_rest(fd, &reader->map, &reader->map_size, &offset))
+    {
+        if (reader->map != NULL)
+        {
+            reader->data = reader->map;
+            reader->pos = offset;
+            reader->len = reader->map_size;
+        }
+        else
+            reader->data = "";
+        reader->eof = true;
+        return reader;
+    }
+
+    reader->size = READ_BUFFER_SIZE;
+    reader->buffer = malloc(reader->size);
+    if (reader->buffer == NULL)
+    {
+        perror("reader_new failed");
+        exit(EXIT_FAILURE);
+    }
+    reader->data = reader->buffer;
+    return reader;
+}
+
+static void reader_close(farpy_reader *reader)
+{
+    if (reader->map != NULL)
+        munmap(reader->map, reader->map_size);
+    free(reader->buffer);
+    free(reader);
+}
+
+/* Moves the unread bytes to the front and reads more after them */
+static void refill(farpy_reader *reader)
+{
+    size_t rest = reader->len - reader->pos;
+    if (reader->pos > 0)
+    {
+        memmove(reader->buffer, reader->buffer + reader->pos, rest);
+        reader->pos = 0;
+        reader->len = rest;
+    }
+
+    /* A line or token longer than the buffer */
+    if (reader->len == reader->size)
+    {
+        reader->size *= 2;
+        char *grown = realloc(reader->buffer, reader->size);
+        if (grown == NULL)
+        {
+            perror("read failed");
+            exit(EXIT_FAILURE);
+        }
+        reader->buffer = grown;
+        reader->data = grown;
+    }
+
+    ssize_t got = read_some(reader->fd, reader->buffer + reader->len,
+                            reader->size - reader->len);
+    if (got == 0)
+        reader->eof = true;
+    reader->len += (size_t)got;
+}
+
+/* lines_new(fd): a line reader over fd, usually 0 for stdin */
+farpy_reader *lines_new(int fd)
+{
+    return reader_new(fd);
+}
+
+/*
+ * lines_next(r): advances to the next line, false at the end of input. The
+ * last line is returned even without a trailing newline, and a "\r" before
+ * the newline is dropped.
+ */
+bool lines_next(farpy_reader *reader)
+{
+    for (;;)
+    {
+        const char *start = reader->data + reader->pos;
+        size_t rest = reader->len - reader->pos;
+        const char *newline = memchr(start + reader->scanned, '\n',
+                                     rest - reader->scanned);
+        if (newline != NULL || reader->eof)
+        {
+            if (newline == NULL && rest == 0)
+                return false;
+
+            size_t len = newline != NULL ? (size_t)(newline - start) : rest;
+            reader->pos += newline != NULL ? len + 1 : len;
+            reader->scanned = 0;
+            if (len > 0 && start[len - 1] == '\r')
+                len--;
+            reader->line = start;
+            reader->line_len = (int64_t)len;
+            return true;
+        }
+
+        reader->scanned = rest;
+        refill(reader);
+    }
+}
+
+/* lines_view(r): the current line, valid until the next lines_next */
+void lines_view(farpy_view *out, farpy_reader *reader)
+{
+    out->data = reader->line;
+    out->len = reader->line_len;
+}
+
+void lines_close(farpy_reader *reader)
+{
+    reader_close(reader);
+}
+
+/*
+ * Scanner: whitespace separated tokens, and numbers parsed straight out of
+ * the read buffer by number.h. A malformed number ends the program, like a
+ * failed read; has_next tells when the input is over.
+ */
+static bool is_space(char c)
+{
+    return c == ' ' || (unsigned char)(c - '\t') < 5;
+}
+
+/* scanner_new(fd): a scanner over fd, usually 0 for stdin */
+farpy_reader *scanner_new(int fd)
+{
+    return reader_new(fd);
+}
+
+/*
+ * Skips whitespace, false at the end of input. The position is kept in
+ * locals: stores through reader would alias the char data and force a
+ * reload on every byte.
+ */
+static inline bool skip_space(farpy_reader *reader)
+{
+    for (;;)
+    {
+        const char *data = reader->data;
+        size_t pos = reader->pos;
+        size_t len = reader->len;
+        while (pos < len && is_space(data[pos]))
+            pos++;
+        reader->pos = pos;
+        if (pos < len)
+            return true;
+        if (reader->eof)
+            return false;
+        refill(reader);
+    }
+}
+
+/* has_next(sc): false once only whitespace is left */
+bool has_next(farpy_reader *reader)
+{
+    return skip_space(reader);
+}
+
+/* next_token(sc): the next token, valid until the next call on sc */
+void next_token(farpy_view *out, farpy_reader *reader)
+{
+    size_t len = 0;
+    if (skip_space(reader))
+    {
+        for (;;)
+        {
+            const char *start = reader->data + reader->pos;
+            size_t rest = reader->len - reader->pos;
+            while (len < rest && !is_space(start[len]))
+                len++;
+            if (len < rest || reader->eof)
+                break;
+            refill(reader);
+        }
+    }
+
+    out->data = reader->data + reader->pos;
+    out->len = (int64_t)len;
+    reader->pos += len;
+}
+
+/* A number parsed in place is whole if whitespace or the input end follows */
+static bool number_done(farpy_reader *reader, int64_t end)
+{
+    if (end < 0)
+        return false;
+    size_t at = reader->pos + (size_t)end;
+    return at < reader->len ? is_space(reader->data[at]) : reader->eof;
+}
+
+static void bad_number(const char *caller, farpy_view token, int64_t end)
+{
+    if (token.len == 0)
+        fprintf(stderr, "%s: no more input\n", caller);
+    else
+        fprintf(stderr, "%s: '%.*s' is %s\n", caller, (int)token.len,
+                token.data, end == -2 ? "out of range" : "not a number");
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * Numbers that number_scan_* leave out, cut off by the end of the buffer,
+ * or malformed
+ */
+static __attribute__((noinline)) int64_t next_i64_slow(farpy_reader *reader)
+{
+    int64_t end = -1;
+    int64_t value = 0;
+    if (skip_space(reader))
+        value = number_parse_i64(reader->data + reader->pos,
+                                 (int64_t)(reader->len - reader->pos), &end);
+    if (number_done(reader, end))
+    {
+        reader->pos += (size_t)end;
+        return value;
+    }
+
+    farpy_view token;
+    next_token(&token, reader);
+    value = number_parse_i64(token.data, token.len, &end);
+    if (end != token.len)
+        bad_number("next_i64", token, end);
+    return value;
+}
+
+static __attribute__((noinline)) double next_f64_slow(farpy_reader *reader)
+{
+    int64_t end = -1;
+    double value = 0;
+    if (skip_space(reader))
+        value = number_parse_f64(reader->data + reader->pos,
+                                 (int64_t)(reader->len - reader->pos), &end);
+    if (number_done(reader, end))
+    {
+        reader->pos += (size_t)end;
+        return value;
+    }
+
+    farpy_view token;
+    next_token(&token, reader);
+    value = number_parse_f64(token.data, token.len, &end);
+    if (end != token.len)
+        bad_number("next_f64", token, end);
+    return value;
+}
+
+/*
+ * Numbers are parsed straight from the buffer. The common forms take the
+ * unchecked parsers while NUMBER_SCAN_SLACK bytes are left to read, and the
+ * whitespace seen to end the number is stepped over with it.
+ */
+int64_t next_i64(farpy_reader *reader)
+{
+    const char *data = reader->data;
+    size_t pos = reader->pos;
+    size_t len = reader->len;
+    while (pos < len && is_space(data[pos]))
+        pos++;
+    if (len - pos >= NUMBER_SCAN_SLACK)
+    {
+        int64_t value;
+        int64_t end = number_scan_i64(data + pos, &value);
+        if (end > 0 && is_space(data[pos + (size_t)end]))
+        {
+            reader->pos = pos + (size_t)end + 1;
+            return value;
+        }
+    }
+    return next_i64_slow(reader);
+}
+
+double next_f64(farpy_reader *reader)
+{
+    const char *data = reader->data;
+    size_t pos = reader->pos;
+    size_t len = reader->len;
+    while (pos < len && is_space(data[pos]))
+        pos++;
+    if (len - pos >= NUMBER_SCAN_SLACK)
+    {
+        double value;
+        int64_t end = number_scan_f64(data + pos, &value);
+        if (end > 0 && is_space(data[pos + (size_t)end]))
+        {
+            reader->pos = pos + (size_t)end + 1;
+            return value;
+        }
+    }
+    return next_f64_slow(reader);
+}
+
+void scanner_close(farpy_reader *reader)
+{
+    reader_close(reader);
+}
+
+/* wtime(): wall-clock seconds from a monotonic clock, for timing loops */
+double wtime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
@@ -10,6 +10,8 @@
 #include <string.h>
 #include <stdlib.h>
 
+/* Only reached when the type name is not a literal; mnew("int") and
+ * alloc<T>(n) are compiled to malloc with a folded size. */
 void *mnew(char *type)
 {
     if (type != NULL)
@@ -0,0 +1,761 @@
+/**
+ * Farpy - A programming language
+ *
+ * Copyright (c) 2025 Fernando (FernandoTheDev)
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file in the project root for full license information.
+ */
+#ifndef FARPY_NUMBER_H
+#define FARPY_NUMBER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "number_pow10.h"
+
+/*
+ * Number parsing and formatting shared by the string and io modules, which
+ * are compiled separately. Nothing here allocates or uses errno.
+ *
+ * The parsers read an optional sign and digits at the start of s[0, len),
+ * without skipping whitespace, and store in `*end` the index just past the
+ * number, -1 when there is none, or -2 when it is out of range (the value
+ * is then clamped); `end` may be null. The formatters write the text
+ * without a NUL to `out`, which needs NUMBER_TEXT_MAX bytes, and return
+ * its length.
+ */
+#define NUMBER_TEXT_MAX 32
+
+static inline bool is_digit(char c)
+{
+    return (unsigned char)(c - '0') < 10;
+}
+
+static inline void set_end(int64_t *end, int64_t value)
+{
+    if (end != NULL)
+        *end = value;
+}
+
+static const uint64_t small_pow10[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+/*
+ * Reads the digits among the 8 bytes at s in one go (SWAR) and returns how
+ * many lead the chunk, with their value (0 for none) in `*value`. s needs 8
+ * readable bytes. The callers carry on digit by digit after it.
+ */
+static inline int eight_digits(const char *s, uint64_t *value)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t chunk;
+    memcpy(&chunk, s, 8);
+    chunk ^= 0x3030303030303030; /* '0'..'9' become 0..9 */
+
+    /* High bit set in every byte above 9; carries only reach later bytes */
+    uint64_t other = ((chunk + 0x7676767676767676) | chunk) &
+                     0x8080808080808080;
+    int count = other != 0 ? __builtin_ctzll(other) / 8 : 8;
+    if (count == 0)
+    {
+        *value = 0;
+        return 0;
+    }
+
+    /* Drop the bytes after the digits; zero bytes come in as leading 0s */
+    chunk <<= 8 * (8 - count);
+    chunk = (chunk * 2561) >> 8;
+    chunk = ((chunk & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+    *value = ((chunk & 0x0000FFFF0000FFFF) * 42949672960001) >> 32;
+    return count;
+#else
+    (void)s;
+    *value = 0;
+    return 0;
+#endif
+}
+
+/* Adds the digits from s[i] on to `*value`, wrapping on overflow, and
+ * returns the index past them */
+static inline int64_t scan_digits(const char *s, int64_t len, int64_t i,
+                                  uint64_t *value)
+{
+    uint64_t v = *value;
+    while (len - i >= 8)
+    {
+        uint64_t chunk;
+        int count = eight_digits(s + i, &chunk);
+        if (count == 0)
+            break;
+        v = v * small_pow10[count] + chunk;
+        i += count;
+        if (count < 8)
+        {
+            *value = v;
+            return i;
+        }
+    }
+
+    for (; i < len && is_digit(s[i]); i++)
+        v = v * 10 + (uint64_t)(s[i] - '0');
+    *value = v;
+    return i;
+}
+
+/* Everything number_parse_i64 leaves out: '+', overflow, long runs of
+ * digits */
+static __attribute__((noinline, unused)) int64_t
+parse_i64_full(const char *s, int64_t len, int64_t *end)
+{
+    int64_t i = 0;
+    bool negative = false;
+    if (i < len && (s[i] == '-' || s[i] == '+'))
+    {
+        negative = s[i] == '-';
+        i++;
+    }
+
+    /* Up to 19 digits cannot overflow a uint64_t; check the rest */
+    int64_t first = i;
+    uint64_t value = 0;
+    while (i < len && i - first < 19 && is_digit(s[i]))
+        value = value * 10 + (uint64_t)(s[i++] - '0');
+
+    bool overflow = false;
+    while (i < len && is_digit(s[i]))
+    {
+        overflow |= __builtin_mul_overflow(value, 10, &value);
+        overflow |= __builtin_add_overflow(value, (uint64_t)(s[i++] - '0'),
+                                           &value);
+    }
+
+    if (i == first)
+    {
+        set_end(end, -1);
+        return 0;
+    }
+
+    if (overflow || value > (uint64_t)INT64_MAX + negative)
+    {
+        set_end(end, -2);
+        return negative ? INT64_MIN : INT64_MAX;
+    }
+
+    set_end(end, i);
+    return negative ? (int64_t)(0 - value) : (int64_t)value;
+}
+
+/* Up to 18 digits always fit, so the common case needs no checks */
+static inline int64_t number_parse_i64(const char *s, int64_t len,
+                                       int64_t *end)
+{
+    bool negative = len > 0 && s[0] == '-';
+    int64_t first = negative;
+    uint64_t value = 0;
+    int64_t i = scan_digits(s, len, first, &value);
+    if (i == first || i - first > 18)
+        return parse_i64_full(s, len, end);
+
+    set_end(end, i);
+    return negative ? (int64_t)(0 - value) : (int64_t)value;
+}
+
+static const double exact_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/*
+ * Eisel-Lemire: the 128-bit product of the normalized mantissa and the
+ * power of ten gives the correctly rounded double, unless it is too close
+ * to a halfway point to tell, or the result is subnormal or infinite; it
+ * returns false then and the caller falls back to strtod.
+ */
+static inline bool eisel_lemire(uint64_t mantissa, int64_t exponent, double *out)
+{
+    if (exponent < POW10_MIN || exponent > POW10_MAX)
+        return false;
+
+    const uint64_t *power = pow10_table[exponent - POW10_MIN];
+    int shift = __builtin_clzll(mantissa);
+    mantissa <<= shift;
+    /* (217706 * e) >> 16 is floor(log2(10^e)) over the table's range */
+    uint64_t exp2 = (uint64_t)(((217706 * exponent) >> 16) + 64 + 1023) -
+                    (uint64_t)shift;
+
+    __uint128_t product = (__uint128_t)mantissa * power[0];
+    uint64_t high = (uint64_t)(product >> 64);
+    uint64_t low = (uint64_t)product;
+
+    /* The low bits may still carry into the high word: use the rest of
+     * the power */
+    if ((high & 0x1FF) == 0x1FF && low + mantissa < mantissa)
+    {
+        __uint128_t wider = (__uint128_t)mantissa * power[1];
+        uint64_t wider_high = (uint64_t)(wider >> 64);
+        uint64_t wider_low = (uint64_t)wider;
+        uint64_t merged_high = high;
+        uint64_t merged_low = low + wider_high;
+        if (merged_low < low)
+            merged_high++;
+
+        if ((merged_high & 0x1FF) == 0x1FF && merged_low + 1 == 0 &&
+            wider_low + mantissa < mantissa)
+            return false;
+        high = merged_high;
+        low = merged_low;
+    }
+
+    uint64_t top = high >> 63;
+    uint64_t bits = high >> (top + 9);
+    exp2 -= 1 ^ top;
+
+    /* Exactly halfway between two doubles as far as we can see */
+    if (low == 0 && (high & 0x1FF) == 0 && (bits & 3) == 1)
+        return false;
+
+    bits += bits & 1;
+    bits >>= 1;
+    if (bits >> 53 > 0)
+    {
+        bits >>= 1;
+        exp2++;
+    }
+
+    if (exp2 - 1 >= 0x7FF - 1)
+        return false;
+
+    bits = exp2 << 52 | (bits & 0x000FFFFFFFFFFFFF);
+    memcpy(out, &bits, sizeof(bits));
+    return true;
+}
+
+/* The text has been validated; strtod only sees digits, '.' and 'e' */
+static inline double parse_f64_slow(const char *s, int64_t len)
+{
+    char small[64];
+    char *text = len < (int64_t)sizeof(small) ? small : malloc((size_t)len + 1);
+    if (text == NULL)
+    {
+        perror("number parsing failed");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(text, s, (size_t)len);
+    text[len] = '\0';
+    double value = strtod(text, NULL);
+    if (text != small)
+        free(text);
+    return value;
+}
+
+/* Case-insensitive match of `word` at s[i] */
+static inline bool match_word(const char *s, int64_t len, int64_t i, const char *word)
+{
+    for (; *word != '\0'; word++, i++)
+        if (i >= len || (s[i] | 0x20) != *word)
+            return false;
+    return true;
+}
+
+/*
+ * Reads the exponent written at s[i], if any, and converts mantissa *
+ * 10^exponent, plus something below one unit when `truncated`. The digits
+ * start at s[first].
+ */
+static __attribute__((noinline, unused)) double
+parse_f64_finish(const char *s, int64_t len, int64_t first, int64_t i,
+                 uint64_t mantissa, int64_t exponent, bool truncated,
+                 bool negative, int64_t *end)
+{
+    /* An exponent without digits ("1e", "2e+") is not part of the number */
+    bool huge_exponent = false;
+    if (i < len && (s[i] | 0x20) == 'e')
+    {
+        int64_t j = i + 1;
+        bool exponent_negative = false;
+        if (j < len && (s[j] == '-' || s[j] == '+'))
+        {
+            exponent_negative = s[j] == '-';
+            j++;
+        }
+
+        if (j < len && is_digit(s[j]))
+        {
+            int64_t written = 0;
+            for (; j < len && is_digit(s[j]); j++)
+            {
+                if (written < 100000)
+                    written = written * 10 + (s[j] - '0');
+                else
+                    huge_exponent = true;
+            }
+            exponent += exponent_negative ? -written : written;
+            i = j;
+        }
+    }
+
+    double value;
+    double upper;
+    if (mantissa == 0)
+        value = 0;
+    else if (!truncated && !huge_exponent && exponent >= -22 &&
+             exponent <= 22 && mantissa <= (uint64_t)1 << 53)
+    {
+        /* Both operands are exact, so one rounding gives the answer */
+        value = (double)mantissa;
+        value = exponent < 0 ? value / exact_pow10[-exponent]
+                             : value * exact_pow10[exponent];
+    }
+    else if (huge_exponent || !eisel_lemire(mantissa, exponent, &value) ||
+             (truncated && (!eisel_lemire(mantissa + 1, exponent, &upper) ||
+                            upper != value)))
+        value = parse_f64_slow(s + first, i - first);
+
+    if (value == __builtin_inf())
+    {
+        set_end(end, -2);
+        return negative ? -value : value;
+    }
+
+    set_end(end, i);
+    return negative ? -value : value;
+}
+
+/* What number_parse_f64 leaves out: '+', words, more than 19 digits */
+static __attribute__((noinline, unused)) double
+parse_f64_full(const char *s, int64_t len, int64_t *end)
+{
+    int64_t i = 0;
+    bool negative = false;
+    if (i < len && (s[i] == '-' || s[i] == '+'))
+    {
+        negative = s[i] == '-';
+        i++;
+    }
+
+    if (match_word(s, len, i, "nan"))
+    {
+        set_end(end, i + 3);
+        return negative ? -__builtin_nan("") : __builtin_nan("");
+    }
+    if (match_word(s, len, i, "inf"))
+    {
+        set_end(end, i + (match_word(s, len, i, "infinity") ? 8 : 3));
+        return negative ? -__builtin_inf() : __builtin_inf();
+    }
+
+    /* The first 19 significant digits go in `mantissa`; the value is
+     * mantissa * 10^exponent, plus something below one unit when
+     * `truncated` */
+    int64_t first = i;
+    uint64_t mantissa = 0;
+    int64_t exponent = 0;
+    int digits = 0;
+    bool truncated = false;
+    bool any = false;
+
+    for (; i < len && is_digit(s[i]); i++)
+    {
+        any = true;
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + (uint64_t)(s[i] - '0');
+            digits += mantissa != 0;
+        }
+        else
+        {
+            exponent++;
+            truncated |= s[i] != '0';
+        }
+    }
+
+    if (i < len && s[i] == '.')
+    {
+        for (i++; i < len && is_digit(s[i]); i++)
+        {
+            any = true;
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (uint64_t)(s[i] - '0');
+                digits += mantissa != 0;
+                exponent--;
+            }
+            else
+                truncated |= s[i] != '0';
+        }
+    }
+
+    if (!any)
+    {
+        set_end(end, -1);
+        return 0;
+    }
+
+    return parse_f64_finish(s, len, first, i, mantissa, exponent, truncated,
+                            negative, end);
+}
+
+/* Numbers with up to 19 digits are scanned here, and plain decimals with
+ * up to 15, where the mantissa and the power of ten are exact doubles,
+ * also converted inline */
+static inline double number_parse_f64(const char *s, int64_t len,
+                                      int64_t *end)
+{
+    bool negative = len > 0 && s[0] == '-';
+    int64_t first = negative;
+    uint64_t mantissa = 0;
+    int64_t i = scan_digits(s, len, first, &mantissa);
+    int64_t count = i - first;
+    int64_t exponent = 0;
+    if (i < len && s[i] == '.')
+    {
+        /* Usually a few digits, cheaper one at a time */
+        int64_t point = i + 1;
+        for (i = point; i < len && is_digit(s[i]); i++)
+            mantissa = mantissa * 10 + (uint64_t)(s[i] - '0');
+        exponent = point - i;
+        count += i - point;
+    }
+
+    if (count == 0 || count > 19)
+        return parse_f64_full(s, len, end);
+    if (count > 15 || (i < len && (s[i] | 0x20) == 'e'))
+        return parse_f64_finish(s, len, first, i, mantissa, exponent, false,
+                                negative, end);
+
+    set_end(end, i);
+    double value = (double)mantissa / exact_pow10[-exponent];
+    return negative ? -value : value;
+}
+
+/*
+ * For callers that can read NUMBER_SCAN_SLACK bytes from s on, such as the
+ * io scanner: the usual forms, without '+', words or an exponent, parsed
+ * with no bounds checks. They return the index past the number, or -1 to
+ * leave the text to number_parse_*, which also reports the errors.
+ */
+#define NUMBER_SCAN_SLACK 48
+
+static inline __attribute__((always_inline)) int64_t
+scan_i64(const char *s, bool negative, int64_t *value)
+{
+    uint64_t digits;
+    int count = eight_digits(s + negative, &digits);
+    if (count == 8)
+    {
+        uint64_t more;
+        int extra = eight_digits(s + negative + 8, &more);
+        digits = digits * small_pow10[extra] + more;
+        count += extra;
+    }
+
+    /* 16 digits may go on, and beyond 18 they may not fit */
+    if (count == 0 || count == 16)
+        return -1;
+    *value = negative ? (int64_t)(0 - digits) : (int64_t)digits;
+    return negative + count;
+}
+
+static inline __attribute__((always_inline)) int64_t
+scan_f64(const char *s, bool negative, double *value)
+{
+    int64_t first = negative;
+    uint64_t mantissa;
+    int64_t i = first + eight_digits(s + first, &mantissa);
+    int64_t integer = i - first;
+    int64_t fraction = 0;
+    if (integer < 8 && s[i] == '.')
+    {
+        /* Usually a few digits, cheaper one at a time */
+        const char *digits = s + i + 1;
+        while (fraction < 8 && is_digit(digits[fraction]))
+            mantissa = mantissa * 10 + (uint64_t)(digits[fraction++] - '0');
+        if (fraction == 8)
+        {
+            uint64_t more;
+            fraction += eight_digits(digits + 8, &more);
+            mantissa = mantissa * small_pow10[fraction - 8] + more;
+        }
+        i += 1 + fraction;
+    }
+
+    int64_t count = integer + fraction;
+    if (count == 0 || count > 19 || integer == 8 || fraction == 16 ||
+        (s[i] | 0x20) == 'e')
+        return -1;
+    if (count > 15)
+    {
+        int64_t end;
+        *value = parse_f64_finish(s, i, first, i, mantissa, -fraction, false,
+                                  negative, &end);
+        return end;
+    }
+
+    double result = (double)(int64_t)mantissa / exact_pow10[fraction];
+    *value = negative ? -result : result;
+    return i;
+}
+
+/*
+ * The sign picks a branch instead of an offset, so loading the digits does
+ * not wait on the load of s[0]: about a quarter faster in the io scanner
+ */
+static inline int64_t number_scan_i64(const char *s, int64_t *value)
+{
+    if (s[0] == '-')
+        return scan_i64(s, true, value);
+    return scan_i64(s, false, value);
+}
+
+static inline int64_t number_scan_f64(const char *s, double *value)
+{
+    if (s[0] == '-')
+        return scan_f64(s, true, value);
+    return scan_f64(s, false, value);
+}
+
+static const char digit_pairs[] = "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899";
+
+static inline int count_digits(uint64_t n)
+{
+    int count = 1;
+    for (uint64_t limit = 10; count < 20 && n >= limit; limit *= 10)
+        count++;
+    return count;
+}
+
+/* Writes the digits of n so that they end at `end`, two at a time */
+static inline void write_digits(char *end, uint64_t n)
+{
+    while (n >= 100)
+    {
+        end -= 2;
+        memcpy(end, digit_pairs + n % 100 * 2, 2);
+        n /= 100;
+    }
+
+    if (n >= 10)
+        memcpy(end - 2, digit_pairs + n * 2, 2);
+    else
+        end[-1] = (char)('0' + n);
+}
+
+static inline int number_format_i64(char *out, int64_t value)
+{
+    uint64_t n = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    int len = count_digits(n) + (value < 0);
+
+    if (value < 0)
+        out[0] = '-';
+    write_digits(out + len, n);
+    return len;
+}
+
+/*
+ * Shortest round-trip formatting (Schubfach): pick the decimal with the
+ * fewest digits inside the interval of values that round to the double,
+ * and the closest one when there are several. The interval bounds are
+ * scaled by a power of ten from pow10_table and rounded to odd, which
+ * keeps the comparisons exact. The text is like %g, with all the digits
+ * needed: 0.1, 1e+17, 5e-324.
+ */
+#define MASK_63 0x7FFFFFFFFFFFFFFF
+
+static inline int floor_log10_pow2(int e)
+{
+    return (int)(e * 661971961083LL >> 41);
+}
+
+static inline int floor_log10_three_quarters_pow2(int e)
+{
+    return (int)((e * 661971961083LL - 274743187321LL) >> 41);
+}
+
+static inline int floor_log2_pow10(int e)
+{
+    return (int)(e * 913124641741LL >> 38);
+}
+
+static inline uint64_t round_to_odd(uint64_t g1, uint64_t g0, uint64_t cp)
+{
+    uint64_t x1 = (uint64_t)(((__uint128_t)g0 * cp) >> 64);
+    __uint128_t y = (__uint128_t)g1 * cp;
+    uint64_t z = ((uint64_t)y >> 1) + x1;
+    uint64_t vbp = (uint64_t)(y >> 64) + (z >> 63);
+    return vbp | (((z & MASK_63) + MASK_63) >> 63);
+}
+
+/* Shortest decimal f * 10^e for c * 2^q */
+static inline void shortest_decimal(int q, uint64_t c, uint64_t *f, int *e)
+{
+    uint64_t out = c & 1;
+    uint64_t cb = c << 2;
+    uint64_t cbr = cb + 2;
+    uint64_t cbl;
+    int k;
+
+    if (c != (uint64_t)1 << 52 || q == -1074)
+    {
+        cbl = cb - 2;
+        k = floor_log10_pow2(q);
+    }
+    else
+    {
+        /* The gap below a power of two is half the gap above */
+        cbl = cb - 1;
+        k = floor_log10_three_quarters_pow2(q);
+    }
+    int h = q + floor_log2_pow10(-k) + 2;
+
+    /* g = floor(10^-k 2^r) + 1, with 2^125 <= g < 2^126 */
+    const uint64_t *power = pow10_table[-k - POW10_MIN];
+    __uint128_t g = (((__uint128_t)power[0] << 64 | power[1]) >> 2) + 1;
+    uint64_t g1 = (uint64_t)(g >> 63);
+    uint64_t g0 = (uint64_t)g & MASK_63;
+
+    uint64_t vb = round_to_odd(g1, g0, cb << h);
+    uint64_t vbl = round_to_odd(g1, g0, cbl << h);
+    uint64_t vbr = round_to_odd(g1, g0, cbr << h);
+
+    uint64_t s = vb >> 2;
+    if (s >= 10)
+    {
+        /* One digit less, if a multiple of ten is in the interval */
+        uint64_t sp10 = 10 * (uint64_t)(((__uint128_t)s * 1844674407370955168ULL) >> 64);
+        uint64_t tp10 = sp10 + 10;
+        bool upin = vbl + out <= sp10 << 2;
+        bool wpin = (tp10 << 2) + out <= vbr;
+        if (upin != wpin)
+        {
+            *f = upin ? sp10 : tp10;
+            *e = k;
+            return;
+        }
+    }
+
+    uint64_t t = s + 1;
+    bool uin = vbl + out <= s << 2;
+    bool win = (t << 2) + out <= vbr;
+    if (uin != win)
+    {
+        *f = uin ? s : t;
+        *e = k;
+        return;
+    }
+
+    /* Both are in the interval: the closer one, the even one on a tie */
+    int64_t distance = (int64_t)(vb - ((s + t) << 1));
+    *f = distance < 0 || (distance == 0 && (s & 1) == 0) ? s : t;
+    *e = k;
+}
+
+static inline int number_format_f64(char *out, double value)
+{
+    char *p = out;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint64_t fraction = bits & 0x000FFFFFFFFFFFFF;
+    int biased = (int)(bits >> 52 & 0x7FF);
+    if (biased == 0x7FF)
+    {
+        const char *special = fraction != 0 ? "nan" : bits >> 63 ? "-inf" : "inf";
+        memcpy(p, special, strlen(special));
+        p += strlen(special);
+    }
+    else
+    {
+        if (bits >> 63)
+            *p++ = '-';
+
+        uint64_t f = 0;
+        int e = 0;
+        if (biased != 0)
+        {
+            uint64_t c = (uint64_t)1 << 52 | fraction;
+            int shift = 1075 - biased;
+            /* Integers below 2^53 are their own shortest form */
+            if (shift > 0 && shift < 53 && (c >> shift) << shift == c)
+                f = c >> shift;
+            else
+                shortest_decimal(-shift, c, &f, &e);
+        }
+        else if (fraction != 0)
+            shortest_decimal(-1074, fraction, &f, &e);
+
+        while (f != 0 && f % 10 == 0)
+        {
+            f /= 10;
+            e++;
+        }
+
+        char digits[20];
+        int count = count_digits(f);
+        write_digits(digits + count, f);
+
+        /* Same switch to scientific notation as %.17g */
+        int point = count + e;
+        if (f == 0)
+            *p++ = '0';
+        else if (point - 1 < -4 || point - 1 >= 17)
+        {
+            *p++ = digits[0];
+            if (count > 1)
+            {
+                *p++ = '.';
+                memcpy(p, digits + 1, (size_t)count - 1);
+                p += count - 1;
+            }
+
+            int exp10 = point - 1;
+            *p++ = 'e';
+            *p++ = exp10 < 0 ? '-' : '+';
+            exp10 = exp10 < 0 ? -exp10 : exp10;
+            if (exp10 >= 100)
+                *p++ = (char)('0' + exp10 / 100);
+            memcpy(p, digit_pairs + exp10 % 100 * 2, 2);
+            p += 2;
+        }
+        else if (point <= 0)
+        {
+            *p++ = '0';
+            *p++ = '.';
+            memset(p, '0', (size_t)-point);
+            p += -point;
+            memcpy(p, digits, (size_t)count);
+            p += count;
+        }
+        else if (point >= count)
+        {
+            memcpy(p, digits, (size_t)count);
+            p += count;
+            memset(p, '0', (size_t)(point - count));
+            p += point - count;
+        }
+        else
+        {
+            memcpy(p, digits, (size_t)point);
+            p += point;
+            *p++ = '.';
+            memcpy(p, digits + point, (size_t)(count - point));
+            p += count - point;
+        }
+    }
+
+    return (int)(p - out);
+}
+
+#endif
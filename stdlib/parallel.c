@@ -0,0 +1,197 @@
+/**
+ * Farpy - A programming language
+ *
+ * Copyright (c) 2025 Fernando (FernandoTheDev)
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file in the project root for full license information.
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Runtime behind `pfor`. The compiler outlines the loop body into
+ * `body(ctx, chunk, lo, hi)`, which runs iterations [lo, hi) and leaves
+ * its reduction partials in slot `chunk`. A loop is cut into a fixed
+ * number of chunks that does not depend on the thread count, and the
+ * caller merges the partials in chunk order, so reductions give the same
+ * result on 1 or N threads.
+ *
+ * Workers are started on the first pfor and stay parked on a condition
+ * variable between loops. The calling thread takes chunks too.
+ */
+typedef void (*farpy_pfor_body)(void *ctx, int64_t chunk, int64_t lo,
+                                int64_t hi);
+
+#define PFOR_MAX_THREADS 256
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    pthread_t workers[PFOR_MAX_THREADS];
+    int started;    /* Worker threads created so far */
+    int threads;    /* Threads a loop runs on, the caller included */
+    int running;    /* Workers still busy with the current loop */
+    int64_t generation;
+
+    farpy_pfor_body body;
+    void *ctx;
+    int64_t count;
+    int64_t chunks;
+    atomic_int_fast64_t next; /* Next unclaimed chunk */
+} farpy_pool;
+
+static farpy_pool pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+/* Nested pfor loops run sequentially on the thread that reaches them */
+static _Thread_local int in_pfor = 0;
+
+static int default_threads(void)
+{
+    const char *env = getenv("FARPY_THREADS");
+    long n = env ? strtol(env, NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (n < 1)
+        n = 1;
+    if (n > PFOR_MAX_THREADS)
+        n = PFOR_MAX_THREADS;
+    return (int)n;
+}
+
+static void run_chunks(void)
+{
+    for (;;)
+    {
+        int64_t chunk = atomic_fetch_add_explicit(&pool.next, 1,
+                                                  memory_order_relaxed);
+        if (chunk >= pool.chunks)
+            return;
+
+        int64_t lo = chunk * pool.count / pool.chunks;
+        int64_t hi = (chunk + 1) * pool.count / pool.chunks;
+        pool.body(pool.ctx, chunk, lo, hi);
+    }
+}
+
+static void *worker(void *arg)
+{
+    int index = (int)(intptr_t)arg;
+    int64_t seen = 0;
+    in_pfor = 1;
+
+    pthread_mutex_lock(&pool.lock);
+    for (;;)
+    {
+        while (pool.generation == seen)
+            pthread_cond_wait(&pool.start, &pool.lock);
+        seen = pool.generation;
+
+        /* Workers past the current thread count sit this loop out */
+        if (index + 1 >= pool.threads)
+            continue;
+
+        pthread_mutex_unlock(&pool.lock);
+        run_chunks();
+        pthread_mutex_lock(&pool.lock);
+
+        if (--pool.running == 0)
+            pthread_cond_signal(&pool.done);
+    }
+
+    return NULL;
+}
+
+static void start_workers(int threads)
+{
+    while (pool.started < threads - 1)
+    {
+        int index = pool.started;
+        if (pthread_create(&pool.workers[index], NULL, worker,
+                           (void *)(intptr_t)index) != 0)
+        {
+            perror("pfor: pthread_create failed");
+            exit(EXIT_FAILURE);
+        }
+        pthread_detach(pool.workers[index]);
+        pool.started++;
+    }
+}
+
+void farpy_pfor(farpy_pfor_body body, void *ctx, int64_t count,
+                int64_t chunks)
+{
+    if (count <= 0)
+        return;
+    if (chunks > count)
+        chunks = count;
+
+    if (pool.threads == 0)
+        pool.threads = default_threads();
+
+    if (in_pfor || pool.threads == 1 || chunks == 1)
+    {
+        for (int64_t chunk = 0; chunk < chunks; chunk++)
+            body(ctx, chunk, chunk * count / chunks,
+                 (chunk + 1) * count / chunks);
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    start_workers(pool.threads);
+    pool.body = body;
+    pool.ctx = ctx;
+    pool.count = count;
+    pool.chunks = chunks;
+    atomic_store_explicit(&pool.next, 0, memory_order_relaxed);
+    pool.running = pool.threads - 1;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.lock);
+
+    in_pfor = 1;
+    run_chunks();
+    in_pfor = 0;
+
+    pthread_mutex_lock(&pool.lock);
+    while (pool.running > 0)
+        pthread_cond_wait(&pool.done, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+}
+
+int parallel_threads()
+{
+    if (pool.threads == 0)
+        pool.threads = default_threads();
+    return pool.threads;
+}
+
+void parallel_set_threads(int threads)
+{
+    if (threads < 1)
+        threads = 1;
+    if (threads > PFOR_MAX_THREADS)
+        threads = PFOR_MAX_THREADS;
+
+    pthread_mutex_lock(&pool.lock);
+    pool.threads = threads;
+    pthread_mutex_unlock(&pool.lock);
+}
+
+/* Wall-clock seconds from a monotonic clock, for timing loops */
+double parallel_wtime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
@@ -0,0 +1,285 @@
+/**
+ * Farpy - A programming language
+ *
+ * Copyright (c) 2025 Fernando (FernandoTheDev)
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file in the project root for full license information.
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Fixed-size object pool behind `pool_new<T>()`. Objects are carved out
+ * of slabs and recycled through free lists threaded through the objects
+ * themselves. Each thread keeps its own free list per pool, so alloc and
+ * free are a pointer pop/push; the shared list is only touched, under the
+ * pool lock, to move POOL_BATCH objects at a time between the two.
+ */
+#define POOL_SLAB_BYTES (64 * 1024)
+#define POOL_MIN_OBJECTS 64
+#define POOL_BATCH 32
+#define POOL_CACHE_SLOTS 16
+
+typedef struct farpy_free
+{
+    struct farpy_free *next;
+} farpy_free;
+
+typedef struct farpy_slab
+{
+    struct farpy_slab *next;
+} farpy_slab;
+
+typedef struct farpy_pool
+{
+    pthread_mutex_t lock;
+    struct farpy_pool *next_live;
+    int64_t serial;        /* Tells thread caches of a destroyed pool apart */
+    size_t size;           /* Object size, rounded up to the alignment */
+    size_t align;
+    size_t per_slab;
+    size_t header;         /* Slab header, padded to the alignment */
+    farpy_slab *slabs;
+    farpy_free *shared;    /* Objects returned by thread caches */
+    unsigned char *bump;   /* Unused tail of the newest slab */
+    size_t bump_left;
+    int64_t slab_count;
+    atomic_int_fast64_t live;
+    atomic_int_fast64_t high_water;
+} farpy_pool;
+
+typedef struct
+{
+    int64_t serial;
+    farpy_free *head;
+    int64_t count;
+} farpy_pool_cache;
+
+static atomic_int_fast64_t next_serial = 1;
+/* Pools not yet destroyed, so a thread can return cached objects */
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static farpy_pool *registry = NULL;
+static _Thread_local farpy_pool_cache caches[POOL_CACHE_SLOTS];
+
+farpy_pool *pool_create(int64_t size, int64_t align)
+{
+    farpy_pool *pool = malloc(sizeof(farpy_pool));
+    if (pool == NULL)
+    {
+        perror("pool_new failed");
+        exit(EXIT_FAILURE);
+    }
+
+    if (align < (int64_t)_Alignof(farpy_free))
+        align = _Alignof(farpy_free);
+    if (size < (int64_t)sizeof(farpy_free))
+        size = sizeof(farpy_free);
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pool->serial = atomic_fetch_add(&next_serial, 1);
+    pool->align = (size_t)align;
+    pool->size = ((size_t)size + pool->align - 1) & ~(pool->align - 1);
+    pool->header = (sizeof(farpy_slab) + pool->align - 1) & ~(pool->align - 1);
+    pool->per_slab = POOL_SLAB_BYTES / pool->size;
+    if (pool->per_slab < POOL_MIN_OBJECTS)
+        pool->per_slab = POOL_MIN_OBJECTS;
+    pool->slabs = NULL;
+    pool->shared = NULL;
+    pool->bump = NULL;
+    pool->bump_left = 0;
+    pool->slab_count = 0;
+    atomic_init(&pool->live, 0);
+    atomic_init(&pool->high_water, 0);
+
+    pthread_mutex_lock(&registry_lock);
+    pool->next_live = registry;
+    registry = pool;
+    pthread_mutex_unlock(&registry_lock);
+    return pool;
+}
+
+static farpy_pool_cache *cache_for(farpy_pool *pool)
+{
+    farpy_pool_cache *cache = &caches[pool->serial % POOL_CACHE_SLOTS];
+
+    /* The slot holds objects of another pool: give them back to it, if it
+     * has not been destroyed, before taking the slot over */
+    if (cache->serial != pool->serial)
+    {
+        pthread_mutex_lock(&registry_lock);
+        farpy_pool *owner = registry;
+        while (owner != NULL && owner->serial != cache->serial)
+            owner = owner->next_live;
+
+        if (owner != NULL && cache->head != NULL)
+        {
+            pthread_mutex_lock(&owner->lock);
+            farpy_free *tail = cache->head;
+            while (tail->next != NULL)
+                tail = tail->next;
+            tail->next = owner->shared;
+            owner->shared = cache->head;
+            pthread_mutex_unlock(&owner->lock);
+        }
+        pthread_mutex_unlock(&registry_lock);
+
+        cache->serial = pool->serial;
+        cache->head = NULL;
+        cache->count = 0;
+    }
+    return cache;
+}
+
+/* Moves up to POOL_BATCH objects into the cache; called with the lock */
+static void refill(farpy_pool *pool, farpy_pool_cache *cache)
+{
+    int64_t moved = 0;
+
+    while (moved < POOL_BATCH && pool->shared != NULL)
+    {
+        farpy_free *object = pool->shared;
+        pool->shared = object->next;
+        object->next = cache->head;
+        cache->head = object;
+        moved++;
+    }
+
+    while (moved < POOL_BATCH)
+    {
+        if (pool->bump_left == 0)
+        {
+            farpy_slab *slab = aligned_alloc(
+                pool->align,
+                (pool->header + pool->per_slab * pool->size + pool->align - 1) &
+                    ~(pool->align - 1));
+            if (slab == NULL)
+            {
+                perror("pool: slab allocation failed");
+                exit(EXIT_FAILURE);
+            }
+
+            slab->next = pool->slabs;
+            pool->slabs = slab;
+            pool->slab_count++;
+            pool->bump = (unsigned char *)slab + pool->header;
+            pool->bump_left = pool->per_slab;
+        }
+
+        farpy_free *object = (farpy_free *)pool->bump;
+        pool->bump += pool->size;
+        pool->bump_left--;
+        object->next = cache->head;
+        cache->head = object;
+        moved++;
+    }
+
+    cache->count += moved;
+}
+
+void *pool_alloc(farpy_pool *pool)
+{
+    farpy_pool_cache *cache = cache_for(pool);
+
+    if (cache->head == NULL)
+    {
+        pthread_mutex_lock(&pool->lock);
+        refill(pool, cache);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    farpy_free *object = cache->head;
+    cache->head = object->next;
+    cache->count--;
+
+    int64_t live = atomic_fetch_add_explicit(&pool->live, 1,
+                                             memory_order_relaxed) + 1;
+    int64_t high = atomic_load_explicit(&pool->high_water,
+                                        memory_order_relaxed);
+    while (live > high &&
+           !atomic_compare_exchange_weak_explicit(&pool->high_water, &high,
+                                                  live, memory_order_relaxed,
+                                                  memory_order_relaxed))
+        ;
+
+    return object;
+}
+
+void pool_free(farpy_pool *pool, void *pointer)
+{
+    if (pointer == NULL)
+        return;
+
+    farpy_pool_cache *cache = cache_for(pool);
+    farpy_free *object = pointer;
+    object->next = cache->head;
+    cache->head = object;
+    cache->count++;
+    atomic_fetch_sub_explicit(&pool->live, 1, memory_order_relaxed);
+
+    /* Hand half of a full cache back so other threads can reuse it */
+    if (cache->count >= 2 * POOL_BATCH)
+    {
+        pthread_mutex_lock(&pool->lock);
+        for (int i = 0; i < POOL_BATCH; i++)
+        {
+            farpy_free *moved = cache->head;
+            cache->head = moved->next;
+            moved->next = pool->shared;
+            pool->shared = moved;
+        }
+        cache->count -= POOL_BATCH;
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+void pool_destroy(farpy_pool *pool)
+{
+    pthread_mutex_lock(&registry_lock);
+    farpy_pool **link = &registry;
+    while (*link != pool)
+        link = &(*link)->next_live;
+    *link = pool->next_live;
+    pthread_mutex_unlock(&registry_lock);
+
+    farpy_pool_cache *cache = &caches[pool->serial % POOL_CACHE_SLOTS];
+    if (cache->serial == pool->serial)
+    {
+        cache->serial = 0;
+        cache->head = NULL;
+        cache->count = 0;
+    }
+
+    farpy_slab *slab = pool->slabs;
+    while (slab != NULL)
+    {
+        farpy_slab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+int64_t pool_live(farpy_pool *pool)
+{
+    return atomic_load_explicit(&pool->live, memory_order_relaxed);
+}
+
+int64_t pool_slabs(farpy_pool *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    int64_t slabs = pool->slab_count;
+    pthread_mutex_unlock(&pool->lock);
+    return slabs;
+}
+
+int64_t pool_high_water(farpy_pool *pool)
+{
+    return atomic_load_explicit(&pool->high_water, memory_order_relaxed);
+}
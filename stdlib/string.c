@@ -11,7 +11,22 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <limits.h>
+#include "number.h"
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Defined by the arena module when it is imported; see arena.c */
+extern void *arena_alloc_current(size_t size) __attribute__((weak));
+
+/* Strings built here come from the current arena, when there is one */
+static char *str_alloc(size_t size)
+{
+    char *result = arena_alloc_current ? arena_alloc_current(size) : NULL;
+    return result != NULL ? result : (char *)malloc(size);
+}
 
 bool str_equals(const char *a, const char *b)
 {
@@ -55,7 +70,7 @@ char *str_slice(const char *str, size_t start, size_t end)
     if (start >= str_len)
     {
         // Return empty string if start is beyond string length
-        char *result = (char *)malloc(1);
+        char *result = str_alloc(1);
         if (result != NULL)
         {
             result[0] = '\0';
@@ -73,7 +88,7 @@ char *str_slice(const char *str, size_t start, size_t end)
     if (end <= start)
     {
         // Return empty string for invalid range
-        char *result = (char *)malloc(1);
+        char *result = str_alloc(1);
         if (result != NULL)
         {
             result[0] = '\0';
@@ -85,7 +100,7 @@ char *str_slice(const char *str, size_t start, size_t end)
     size_t slice_len = end - start;
 
     // Allocate memory for the new string (+1 for null terminator)
-    char *result = (char *)malloc(slice_len + 1);
+    char *result = str_alloc(slice_len + 1);
     if (result == NULL)
     {
         // Handle memory allocation failure
@@ -149,14 +164,683 @@ char *str_concat(const char *str1, const char *str2)
     size_t len1 = strlen(str1);
     size_t len2 = strlen(str2);
 
-    char *result = (char *)malloc(len1 + len2 + 1);
+    char *result = str_alloc(len1 + len2 + 1);
     if (result == NULL)
     {
         return NULL;
     }
 
-    strcpy(result, str1);
-    strcat(result, str2);
+    memcpy(result, str1, len1);
+    memcpy(result + len1, str2, len2 + 1);
 
     return result;
 }
+
+/*
+ * Length-aware variants for string views (`string[:]`). A view is passed
+ * as a pointer + length pair and is not NUL-terminated, so none of these
+ * call strlen or read past `len` bytes.
+ */
+bool view_equals(const char *a, int64_t a_len, const char *b, int64_t b_len)
+{
+    return a_len == b_len && memcmp(a, b, (size_t)a_len) == 0;
+}
+
+int64_t view_find(const char *s, int64_t len, const char *needle,
+                  int64_t needle_len)
+{
+    if (needle_len == 0)
+        return 0;
+    if (needle_len > len)
+        return -1;
+
+    const char *last = s + (len - needle_len);
+    const char *p = s;
+
+    while (p <= last)
+    {
+        p = memchr(p, needle[0], (size_t)(last - p + 1));
+        if (p == NULL)
+            return -1;
+        if (memcmp(p, needle, (size_t)needle_len) == 0)
+            return p - s;
+        p++;
+    }
+
+    return -1;
+}
+
+bool view_starts_with(const char *s, int64_t len, const char *prefix,
+                      int64_t prefix_len)
+{
+    return prefix_len <= len && memcmp(s, prefix, (size_t)prefix_len) == 0;
+}
+
+bool view_ends_with(const char *s, int64_t len, const char *suffix,
+                    int64_t suffix_len)
+{
+    return suffix_len <= len &&
+           memcmp(s + len - suffix_len, suffix, (size_t)suffix_len) == 0;
+}
+
+/* Clamps on overflow like str_to_int; 0 when there is no number */
+int64_t view_to_int(const char *s, int64_t len)
+{
+    int64_t i = 0;
+
+    // Skip leading whitespace
+    while (i < len && (s[i] == ' ' || s[i] == '\t' || s[i] == '\n'))
+        i++;
+
+    return number_parse_i64(s + i, len - i, NULL);
+}
+
+char *view_to_string(const char *s, int64_t len)
+{
+    char *result = str_alloc((size_t)len + 1);
+    if (result == NULL)
+    {
+        perror("Memory allocation failed in view_to_string");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(result, s, (size_t)len);
+    result[len] = '\0';
+
+    return result;
+}
+
+void view_print(const char *s, int64_t len)
+{
+    fwrite(s, 1, (size_t)len, stdout);
+}
+
+/*
+ * Search over views. On x86-64 substring search tests a whole block of
+ * candidate positions at once: a position can only match if both the
+ * first and the last byte of the needle are in place, so two byte
+ * compares over 32 (AVX2) or 16 (SSE2) positions leave very few
+ * candidates for memcmp. Byte-set scans look both nibbles of each byte
+ * up in a bit matrix of the set with AVX2 shuffles, or use SSE4.2 string
+ * compares for sets of up to 16 bytes. The kernels are picked once, at
+ * startup, from what the CPU supports; other targets and block tails use
+ * scalar code.
+ */
+enum
+{
+    SIMD_NONE,
+    SIMD_SSE2,
+    SIMD_SSE42,
+    SIMD_AVX2,
+};
+
+static int simd_level = SIMD_NONE;
+
+#if defined(__x86_64__)
+__attribute__((constructor)) static void detect_simd(void)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        simd_level = SIMD_AVX2;
+    else if (__builtin_cpu_supports("sse4.2"))
+        simd_level = SIMD_SSE42;
+    else
+        simd_level = SIMD_SSE2;
+}
+#endif
+
+static int64_t find_scalar(const char *s, int64_t len, const char *needle,
+                           int64_t needle_len)
+{
+    const char *last = s + (len - needle_len);
+    const char *p = s;
+
+    while (p <= last)
+    {
+        p = memchr(p, needle[0], (size_t)(last - p + 1));
+        if (p == NULL)
+            return -1;
+        if (memcmp(p, needle, (size_t)needle_len) == 0)
+            return p - s;
+        p++;
+    }
+
+    return -1;
+}
+
+static int64_t rfind_scalar(const char *s, int64_t len, const char *needle,
+                            int64_t needle_len)
+{
+    for (int64_t i = len - needle_len; i >= 0; i--)
+    {
+        if (s[i] == needle[0] &&
+            memcmp(s + i, needle, (size_t)needle_len) == 0)
+            return i;
+    }
+    return -1;
+}
+
+#if defined(__x86_64__)
+/* Both kernels need needle_len >= 2 and stop where a block would read
+ * past `len`; the caller finishes the tail. `mask` bit k set means
+ * position i + k matches the first and last byte of the needle. */
+__attribute__((target("avx2"))) static int64_t
+find_avx2(const char *s, int64_t len, const char *needle, int64_t needle_len,
+          int64_t *stop)
+{
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+    int64_t i = 0;
+
+    for (; i + needle_len + 31 <= len; i += 32)
+    {
+        __m256i head = _mm256_loadu_si256((const __m256i *)(s + i));
+        __m256i tail =
+            _mm256_loadu_si256((const __m256i *)(s + i + needle_len - 1));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last)));
+
+        while (mask != 0)
+        {
+            int k = __builtin_ctz(mask);
+            if (memcmp(s + i + k + 1, needle + 1, (size_t)needle_len - 2) == 0)
+                return i + k;
+            mask &= mask - 1;
+        }
+    }
+
+    *stop = i;
+    return -1;
+}
+
+static int64_t find_sse2(const char *s, int64_t len, const char *needle,
+                         int64_t needle_len, int64_t *stop)
+{
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needle_len - 1]);
+    int64_t i = 0;
+
+    for (; i + needle_len + 15 <= len; i += 16)
+    {
+        __m128i head = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i tail = _mm_loadu_si128((const __m128i *)(s + i + needle_len - 1));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+
+        while (mask != 0)
+        {
+            int k = __builtin_ctz(mask);
+            if (memcmp(s + i + k + 1, needle + 1, (size_t)needle_len - 2) == 0)
+                return i + k;
+            mask &= mask - 1;
+        }
+    }
+
+    *stop = i;
+    return -1;
+}
+
+/* Same test walking backwards; blocks end at the last candidate position
+ * and the highest set bit is the rightmost match. */
+__attribute__((target("avx2"))) static int64_t
+rfind_avx2(const char *s, int64_t len, const char *needle, int64_t needle_len,
+           int64_t *stop)
+{
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+    int64_t i = len - needle_len - 31;
+
+    for (; i >= 0; i -= 32)
+    {
+        __m256i head = _mm256_loadu_si256((const __m256i *)(s + i));
+        __m256i tail =
+            _mm256_loadu_si256((const __m256i *)(s + i + needle_len - 1));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last)));
+
+        while (mask != 0)
+        {
+            int k = 31 - __builtin_clz(mask);
+            if (memcmp(s + i + k + 1, needle + 1, (size_t)needle_len - 2) == 0)
+                return i + k;
+            mask &= ~(1u << k);
+        }
+    }
+
+    /* Positions 0 .. i + 31 are left */
+    *stop = i + 31 + needle_len;
+    return -1;
+}
+
+/* Byte-set membership for 32 bytes at a time, for a set of any size:
+ * the set is a 16x16 bit matrix indexed by the two nibbles of a byte.
+ * `rows_low[lo]` holds the bits for high nibbles 0-7 and `rows_high[lo]`
+ * those for 8-15; a shuffle looks both up, another one turns the high
+ * nibble into its bit. Stops like the find kernels. */
+__attribute__((target("avx2"))) static int64_t
+scan_avx2(const char *s, int64_t len, const char *set, int64_t set_len,
+          bool negate, int64_t *stop)
+{
+    uint8_t rows_low[16] = {0};
+    uint8_t rows_high[16] = {0};
+    for (int64_t i = 0; i < set_len; i++)
+    {
+        uint8_t c = (uint8_t)set[i];
+        if (c < 0x80)
+            rows_low[c & 15] |= (uint8_t)(1u << (c >> 4));
+        else
+            rows_high[c & 15] |= (uint8_t)(1u << ((c >> 4) - 8));
+    }
+
+    const __m256i low_table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)rows_low));
+    const __m256i high_table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)rows_high));
+    const __m256i bits = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i seven = _mm256_set1_epi8(7);
+    const __m256i zero = _mm256_setzero_si256();
+    int64_t i = 0;
+
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(s + i));
+        __m256i lo = _mm256_and_si256(block, nibble);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble);
+        __m256i row = _mm256_blendv_epi8(
+            _mm256_shuffle_epi8(low_table, lo),
+            _mm256_shuffle_epi8(high_table, lo), _mm256_cmpgt_epi8(hi, seven));
+        __m256i absent = _mm256_cmpeq_epi8(
+            _mm256_and_si256(row, _mm256_shuffle_epi8(bits, hi)), zero);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(absent);
+        if (!negate)
+            mask = ~mask;
+
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+
+    *stop = i;
+    return -1;
+}
+
+/* The same with SSE4.2 string compares, for sets of 1 to 16 bytes */
+__attribute__((target("sse4.2"))) static int64_t
+scan_sse42(const char *s, int64_t len, const char *set, int64_t set_len,
+           bool negate, int64_t *stop)
+{
+    char bytes[16] = {0};
+    memcpy(bytes, set, (size_t)set_len);
+    const __m128i chars = _mm_loadu_si128((const __m128i *)bytes);
+    int64_t i = 0;
+
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(s + i));
+        int at = negate
+                     ? _mm_cmpestri(chars, (int)set_len, block, 16,
+                                    _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY |
+                                        _SIDD_NEGATIVE_POLARITY)
+                     : _mm_cmpestri(chars, (int)set_len, block, 16,
+                                    _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY);
+        if (at < 16)
+            return i + at;
+    }
+
+    *stop = i;
+    return -1;
+}
+#endif
+
+int64_t str_find(const char *s, int64_t len, const char *needle,
+                 int64_t needle_len)
+{
+    if (needle_len == 0)
+        return 0;
+    if (needle_len > len)
+        return -1;
+    if (needle_len == 1)
+    {
+        const char *p = memchr(s, needle[0], (size_t)len);
+        return p == NULL ? -1 : p - s;
+    }
+
+    int64_t done = 0;
+#if defined(__x86_64__)
+    int64_t found = simd_level == SIMD_AVX2
+                        ? find_avx2(s, len, needle, needle_len, &done)
+                        : find_sse2(s, len, needle, needle_len, &done);
+    if (found >= 0)
+        return found;
+#endif
+
+    int64_t rest = find_scalar(s + done, len - done, needle, needle_len);
+    return rest < 0 ? -1 : done + rest;
+}
+
+int64_t str_rfind(const char *s, int64_t len, const char *needle,
+                  int64_t needle_len)
+{
+    if (needle_len == 0)
+        return len;
+    if (needle_len > len)
+        return -1;
+
+    int64_t rest = len;
+#if defined(__x86_64__)
+    if (simd_level == SIMD_AVX2 && needle_len >= 2)
+    {
+        int64_t found = rfind_avx2(s, len, needle, needle_len, &rest);
+        if (found >= 0)
+            return found;
+    }
+#endif
+
+    return rfind_scalar(s, rest, needle, needle_len);
+}
+
+/* Non-overlapping occurrences; an empty needle counts as none */
+int64_t str_count(const char *s, int64_t len, const char *needle,
+                  int64_t needle_len)
+{
+    if (needle_len == 0)
+        return 0;
+
+    int64_t count = 0;
+    int64_t at = 0;
+
+    for (;;)
+    {
+        int64_t found = str_find(s + at, len - at, needle, needle_len);
+        if (found < 0)
+            return count;
+        count++;
+        at += found + needle_len;
+    }
+}
+
+/* Field splitting without allocating: the field starting at `from` ends
+ * at the returned index, where the next `sep` (or the end of s) is. The
+ * next field starts at that index plus the separator's length. */
+int64_t str_split(const char *s, int64_t len, const char *sep,
+                  int64_t sep_len, int64_t from)
+{
+    if (from >= len)
+        return len;
+    if (from < 0)
+        from = 0;
+
+    int64_t found = sep_len == 0 ? -1
+                                 : str_find(s + from, len - from, sep, sep_len);
+    return found < 0 ? len : from + found;
+}
+
+static int64_t scan_bytes(const char *s, int64_t len, const char *set,
+                          int64_t set_len, bool negate)
+{
+    int64_t done = 0;
+#if defined(__x86_64__)
+    if (simd_level == SIMD_AVX2)
+    {
+        int64_t found = scan_avx2(s, len, set, set_len, negate, &done);
+        if (found >= 0)
+            return found;
+    }
+    else if (simd_level == SIMD_SSE42 && set_len > 0 && set_len <= 16)
+    {
+        int64_t found = scan_sse42(s, len, set, set_len, negate, &done);
+        if (found >= 0)
+            return found;
+    }
+#endif
+
+    bool in_set[256] = {false};
+    for (int64_t i = 0; i < set_len; i++)
+        in_set[(unsigned char)set[i]] = true;
+
+    for (int64_t i = done; i < len; i++)
+    {
+        if (in_set[(unsigned char)s[i]] != negate)
+            return i;
+    }
+    return -1;
+}
+
+/* Index of the first byte of s that occurs in `set`, or -1 */
+int64_t str_find_any(const char *s, int64_t len, const char *set,
+                     int64_t set_len)
+{
+    return scan_bytes(s, len, set, set_len, false);
+}
+
+/* Index of the first byte of s that does not occur in `set`, or -1:
+ * str_skip_any(line, " \t") skips leading blanks */
+int64_t str_skip_any(const char *s, int64_t len, const char *set,
+                     int64_t set_len)
+{
+    return scan_bytes(s, len, set, set_len, true);
+}
+
+bool str_contains_any(const char *s, int64_t len, const char *set,
+                      int64_t set_len)
+{
+    return scan_bytes(s, len, set, set_len, false) >= 0;
+}
+
+/* Byte-wise order of two views: negative, zero or positive like strcmp */
+int str_compare(const char *a, int64_t a_len, const char *b, int64_t b_len)
+{
+    int order = memcmp(a, b, (size_t)(a_len < b_len ? a_len : b_len));
+    if (order != 0)
+        return order < 0 ? -1 : 1;
+    return a_len < b_len ? -1 : a_len > b_len;
+}
+
+/*
+ * Numbers over views and caller buffers, see number.h. The formatters
+ * write the text and a NUL and return the length, or -1 when `cap` bytes
+ * are not enough; 32 bytes fit any i64 or f64.
+ */
+int64_t parse_i64(const char *s, int64_t len, int64_t *end)
+{
+    return number_parse_i64(s, len, end);
+}
+
+double parse_f64(const char *s, int64_t len, int64_t *end)
+{
+    return number_parse_f64(s, len, end);
+}
+
+static int64_t copy_number(char *buf, int64_t cap, const char *text, int len)
+{
+    if (len + 1 > cap)
+        return -1;
+    memcpy(buf, text, (size_t)len);
+    buf[len] = '\0';
+    return len;
+}
+
+int64_t fmt_i64(char *buf, int64_t cap, int64_t value)
+{
+    char text[NUMBER_TEXT_MAX];
+    return copy_number(buf, cap, text, number_format_i64(text, value));
+}
+
+int64_t fmt_f64(char *buf, int64_t cap, double value)
+{
+    char text[NUMBER_TEXT_MAX];
+    return copy_number(buf, cap, text, number_format_f64(text, value));
+}
+
+/*
+ * Fat strings (`str`): the length travels with the pointer. `data` is
+ * NULL when the text (up to FARPY_STR_INLINE - 1 bytes) is stored inline
+ * in `small`; literals point at their static bytes. Either way the text is
+ * NUL-terminated, which is what `.cstr()` relies on. The compiler lays the
+ * type out as %farpy.str = { i8*, i64, [16 x i8] } and passes it by
+ * pointer, with results written through `out`.
+ */
+#define FARPY_STR_INLINE 16
+
+typedef struct
+{
+    char *data;
+    int64_t len;
+    char small[FARPY_STR_INLINE];
+} farpy_str;
+
+static char *fat_buffer(farpy_str *out, int64_t len)
+{
+    out->len = len;
+    if (len < FARPY_STR_INLINE)
+    {
+        out->data = NULL;
+        return out->small;
+    }
+
+    out->data = str_alloc((size_t)len + 1);
+    if (out->data == NULL)
+    {
+        perror("Memory allocation failed in str");
+        exit(EXIT_FAILURE);
+    }
+    return out->data;
+}
+
+void str_from(farpy_str *out, const char *s, int64_t len)
+{
+    char *text = fat_buffer(out, len);
+    memcpy(text, s, (size_t)len);
+    text[len] = '\0';
+}
+
+void str_cat(farpy_str *out, const char *a, int64_t a_len, const char *b,
+             int64_t b_len)
+{
+    char *text = fat_buffer(out, a_len + b_len);
+    memcpy(text, a, (size_t)a_len);
+    memcpy(text + a_len, b, (size_t)b_len);
+    text[a_len + b_len] = '\0';
+}
+
+/*
+ * String builder: a growable buffer that appends in amortized O(1). The
+ * text is kept NUL-terminated, and sb_finish hands the buffer itself to
+ * the caller (release it with free), so building never copies twice.
+ */
+typedef struct
+{
+    char *data;
+    size_t len;
+    size_t cap; /* Bytes available for text, not counting the NUL */
+} farpy_builder;
+
+static void sb_grow(farpy_builder *sb, size_t needed)
+{
+    size_t cap = sb->cap ? sb->cap : 16;
+    while (cap < needed)
+        cap *= 2;
+
+    char *data = realloc(sb->data, cap + 1);
+    if (data == NULL)
+    {
+        perror("Memory allocation failed in string builder");
+        exit(EXIT_FAILURE);
+    }
+
+    sb->data = data;
+    sb->cap = cap;
+}
+
+farpy_builder *sb_new(int64_t capacity)
+{
+    farpy_builder *sb = malloc(sizeof(farpy_builder));
+    if (sb == NULL)
+    {
+        perror("Memory allocation failed in sb_new");
+        exit(EXIT_FAILURE);
+    }
+
+    sb->data = NULL;
+    sb->len = 0;
+    sb->cap = 0;
+    sb_grow(sb, capacity > 0 ? (size_t)capacity : 16);
+    sb->data[0] = '\0';
+    return sb;
+}
+
+void sb_reserve(farpy_builder *sb, int64_t extra)
+{
+    if (extra > 0 && sb->len + (size_t)extra > sb->cap)
+        sb_grow(sb, sb->len + (size_t)extra);
+}
+
+static void sb_write(farpy_builder *sb, const char *text, size_t len)
+{
+    if (sb->len + len > sb->cap)
+        sb_grow(sb, sb->len + len);
+
+    memcpy(sb->data + sb->len, text, len);
+    sb->len += len;
+    sb->data[sb->len] = '\0';
+}
+
+void sb_append(farpy_builder *sb, const char *text)
+{
+    sb_write(sb, text, strlen(text));
+}
+
+void sb_append_char(farpy_builder *sb, int c)
+{
+    if (sb->len + 1 > sb->cap)
+        sb_grow(sb, sb->len + 1);
+
+    sb->data[sb->len++] = (char)c;
+    sb->data[sb->len] = '\0';
+}
+
+void sb_append_int(farpy_builder *sb, int64_t value)
+{
+    char digits[20];
+    char *end = digits + sizeof(digits);
+    char *p = end;
+    uint64_t n = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+
+    do
+    {
+        *--p = (char)('0' + n % 10);
+        n /= 10;
+    } while (n != 0);
+
+    if (value < 0)
+        sb_append_char(sb, '-');
+    sb_write(sb, p, (size_t)(end - p));
+}
+
+/* Shortest text that reads back as the same double, like fmt_f64 */
+void sb_append_float(farpy_builder *sb, double value)
+{
+    char text[NUMBER_TEXT_MAX];
+    sb_write(sb, text, (size_t)number_format_f64(text, value));
+}
+
+int64_t sb_len(farpy_builder *sb)
+{
+    return (int64_t)sb->len;
+}
+
+void sb_clear(farpy_builder *sb)
+{
+    sb->len = 0;
+    sb->data[0] = '\0';
+}
+
+/* Returns the built string and releases the builder */
+char *sb_finish(farpy_builder *sb)
+{
+    char *data = sb->data;
+    free(sb);
+    return data;
+}
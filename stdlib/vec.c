@@ -0,0 +1,50 @@
+/**
+ * Farpy - A programming language
+ *
+ * Copyright (c) 2025 Fernando (FernandoTheDev)
+ *
+ * This software is licensed under the MIT License.
+ * See the LICENSE file in the project root for full license information.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+ * Layout shared by every `T[..]` vector (`%farpy.vec.T` in the IR).
+ * push/len/cap/clear are emitted inline by the compiler for each element
+ * type; only the slow paths live here.
+ */
+typedef struct
+{
+    void *data;
+    int64_t len;
+    int64_t cap;
+} farpy_vec;
+
+#define VEC_MIN_CAPACITY 8
+
+void vec_grow(farpy_vec *vec, int64_t elem_size, int64_t min_cap)
+{
+    int64_t cap = vec->cap > 0 ? vec->cap * 2 : VEC_MIN_CAPACITY;
+    if (cap < min_cap)
+        cap = min_cap;
+
+    void *data = realloc(vec->data, (size_t)(cap * elem_size));
+    if (data == NULL)
+    {
+        perror("vec_grow failed");
+        exit(EXIT_FAILURE);
+    }
+
+    vec->data = data;
+    vec->cap = cap;
+}
+
+void vec_release(farpy_vec *vec)
+{
+    free(vec->data);
+    vec->data = NULL;
+    vec->len = 0;
+    vec->cap = 0;
+}
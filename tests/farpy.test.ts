@@ -6,13 +6,33 @@
  * This software is licensed under the MIT License.
  * See the LICENSE file in the project root for full license information.
  */
-import { assertEquals } from "jsr:@std/assert";
+import { assertEquals, assertStringIncludes } from "jsr:@std/assert";
 import { FarpyCompilerMain } from "../farpy.ts";
+import { DiagnosticReporter } from "../src/error/diagnosticReporter.ts";
+import { Lexer } from "../src/frontend/lexer/lexer.ts";
+import { Parser } from "../src/frontend/parser/parser.ts";
+import { Semantic } from "../src/middle/semantic.ts";
 
 function createFreshCompiler(args: string[]) {
   return new FarpyCompilerMain(args);
 }
 
+// Runs the semantic analysis alone and returns its diagnostics, for
+// programs it has to reject: the compiler would print them and exit.
+function semanticErrors(source: string): string {
+  const reporter = new DiagnosticReporter();
+  const tokens = new Lexer("test.fp", source, Deno.cwd() + "/", reporter)
+    .tokenize();
+  const ast = new Parser(tokens, reporter).parse();
+  const semantic = Semantic.getInstance(reporter);
+  try {
+    semantic.semantic(ast);
+  } finally {
+    semantic.resetInstance();
+  }
+  return reporter.formatDiagnostics();
+}
+
 Deno.test({
   name: "calc.fp",
   fn: async () => {
@@ -227,7 +247,7 @@ Deno.test({
 
     assertEquals(
       outText,
-      "1.000000\n1.071773\n",
+      "1.000000\n100.000000\n",
       "A saída do programa não corresponde ao valor esperado",
     );
 
@@ -345,3 +365,993 @@ Deno.test({
     await Deno.remove(outputPath);
   },
 });
+
+Deno.test({
+  name: "loop_hints.fp",
+  fn: async () => {
+    const outputPath = "tests/test_loop_hints";
+    const compiler = createFreshCompiler([
+      "examples/loop_hints.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "499500 10\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "tail_rec.fp",
+  fn: async () => {
+    const outputPath = "tests/test_tail_rec";
+    const compiler = createFreshCompiler([
+      "examples/tail_rec.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "1000000\n4\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "globals.fp",
+  fn: async () => {
+    const outputPath = "tests/test_globals";
+    const compiler = createFreshCompiler([
+      "examples/globals.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "scale\n40\n1\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "lookup_table.fp",
+  fn: async () => {
+    const outputPath = "tests/test_lookup_table";
+    const compiler = createFreshCompiler([
+      "examples/lookup_table.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "25 9\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "vectors.fp",
+  fn: async () => {
+    const outputPath = "tests/test_vectors";
+    const compiler = createFreshCompiler([
+      "examples/vectors.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "1000 998001 285\n0 1024\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "views.fp",
+  fn: async () => {
+    const outputPath = "tests/test_views";
+    const compiler = createFreshCompiler([
+      "examples/views.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "GET /index.html\n[]\nhtml\n201 16 i\n3 4\n9223372036854775807 0\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "bounds.fp",
+  fn: async () => {
+    const outputPath = "tests/test_bounds";
+    const compiler = createFreshCompiler([
+      "examples/bounds.fp",
+      "--opt",
+      "--bounds-check",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "19 60 6 3\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "types.fp",
+  fn: async () => {
+    const outputPath = "tests/test_types";
+    const compiler = createFreshCompiler([
+      "examples/types.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "27.5 27 1\n0.3333333333 0.3333333433\n3.5 -2\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "math.fp",
+  fn: async () => {
+    const outputPath = "tests/test_math";
+    const compiler = createFreshCompiler([
+      "examples/math.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "1.414214 338350.0 8.000\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "simd.fp",
+  fn: async () => {
+    const outputPath = "tests/test_simd";
+    const compiler = createFreshCompiler([
+      "examples/simd.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "8.5 87.0 4 4 24\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "pfor.fp",
+  fn: async () => {
+    const outputPath = "tests/test_pfor";
+    const compiler = createFreshCompiler([
+      "examples/pfor.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "249750.0 250500 1307674368000\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "atomics.fp",
+  fn: async () => {
+    const outputPath = "tests/test_atomics";
+    const compiler = createFreshCompiler([
+      "examples/atomics.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "10000 49995000 999 0\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "arena.fp",
+  fn: async () => {
+    const outputPath = "tests/test_arena";
+    const compiler = createFreshCompiler([
+      "examples/arena.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "abcd 128\n0\nhello, region\n13 9000\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "alloc.fp",
+  fn: async () => {
+    const outputPath = "tests/test_alloc";
+    const compiler = createFreshCompiler([
+      "examples/alloc.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "0 0.0\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "pool.fp",
+  fn: async () => {
+    const outputPath = "tests/test_pool";
+    const compiler = createFreshCompiler([
+      "examples/pool.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "2 1 5\n0\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "string_builder.fp",
+  fn: async () => {
+    const outputPath = "tests/test_string_builder";
+    const compiler = createFreshCompiler([
+      "examples/string_builder.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "43\n0,1,4,9,16, pi=3.25 sum=0.30000000000000004\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "fat_strings.fp",
+  fn: async () => {
+    const outputPath = "tests/test_fat_strings";
+    const compiler = createFreshCompiler([
+      "examples/fat_strings.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "11 fat strings\n12 hello, farpy\n44\nfrom a C string\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "string_search.fp",
+  fn: async () => {
+    const outputPath = "tests/test_string_search";
+    const compiler = createFreshCompiler([
+      "examples/string_search.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "25 53 3\n47 10 0\n2025-01-01|12:00:03|WARN|disk=/dev/sda1|used=91%|free=8.2G|\n1 -1\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "numbers.fp",
+  fn: async () => {
+    const outputPath = "tests/test_numbers";
+    const compiler = createFreshCompiler([
+      "examples/numbers.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "-42 3\n325 6\n9223372036854775807 -2\n0 -1\n0.30000000000000004 19\n1.23456789e+17\n-9000 -1\n2147483647\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "writer.fp",
+  fn: async () => {
+    const outputPath = "tests/test_writer";
+    const compiler = createFreshCompiler([
+      "examples/writer.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "line 1 0.125\nline 2 0.25\nline 3 0.375\nafter flush\nwritten at exit\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "lines.fp",
+  fn: async () => {
+    const outputPath = "tests/test_lines";
+    const compiler = createFreshCompiler([
+      "examples/lines.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const child = new Deno.Command(outputPath, {
+      stdin: "piped",
+      stdout: "piped",
+      stderr: "piped",
+    }).spawn();
+
+    const input = child.stdin.getWriter();
+    await input.write(
+      new TextEncoder().encode("first\r\n\nthird line\nno newline"),
+    );
+    await input.close();
+
+    const { code, stdout, stderr } = await child.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "5 first\n0 \n10 third line\n10 no newline\n4 lines\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "scanner.fp",
+  fn: async () => {
+    const outputPath = "tests/test_scanner";
+    const compiler = createFreshCompiler([
+      "examples/scanner.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const child = new Deno.Command(outputPath, {
+      stdin: "piped",
+      stdout: "piped",
+      stderr: "piped",
+    }).spawn();
+
+    const input = child.stdin.getWriter();
+    await input.write(
+      new TextEncoder().encode("apple 3 0.5\n  pear\t-2 1.25e1\r\nfig 10 +.1"),
+    );
+    await input.close();
+
+    const { code, stdout, stderr } = await child.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "apple 3\npear -2\nfig 10\ntotal -22.50\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "file.fp",
+  fn: async () => {
+    const outputPath = "tests/test_file";
+    const compiler = createFreshCompiler([
+      "examples/file.fp",
+      "--opt",
+      "--o",
+      outputPath,
+    ]);
+
+    await compiler.run();
+    const runCmd = new Deno.Command(outputPath, {
+      stdout: "piped",
+      stderr: "piped",
+    });
+
+    const { code, stdout, stderr } = await runCmd.output();
+    const outText = new TextDecoder().decode(stdout);
+    const errText = new TextDecoder().decode(stderr);
+
+    if (code !== 0) {
+      throw new Error(
+        `Execução falhou (exit code ${code}):\n${errText}`,
+      );
+    }
+
+    assertEquals(
+      outText,
+      "21 bytes\nLINE 1\nline 2\nline 3\n3 lines\n6: line 2\n",
+      "A saída do programa não corresponde ao valor esperado",
+    );
+
+    await Deno.remove(outputPath);
+  },
+});
+
+Deno.test({
+  name: "pfor rejects writes to a shared struct",
+  fn: () => {
+    assertStringIncludes(
+      semanticErrors(`import "parallel"
+struct Point {
+    x: int;
+    y: int;
+}
+new p = Point { x: 1, y: 2 }
+pfor 0..10 -> i {
+    p.x = i
+}
+`),
+      "'p' is shared by every pfor thread",
+    );
+  },
+});
+
+Deno.test({
+  name: "pfor rejects vec_* mutators on a shared vector",
+  fn: () => {
+    for (
+      const call of ["vec_push(v, i)", "vec_clear(v)", "vec_reserve(v, 8)"]
+    ) {
+      assertStringIncludes(
+        semanticErrors(`import "parallel"
+import "vec"
+new mut v: int[..] = [0]
+pfor 0..10 -> i {
+    ${call}
+}
+`),
+        "'v' is shared by every pfor thread",
+      );
+    }
+  },
+});
+
+Deno.test({
+  name: "pfor counter and body locals end with the loop",
+  fn: () => {
+    assertStringIncludes(
+      semanticErrors(`import "io"
+import "parallel"
+pfor 0..10 -> i {
+    new sq = i * i
+}
+printf("%d\\n", i)
+`),
+      "Variable 'i' is not defined",
+    );
+    assertStringIncludes(
+      semanticErrors(`import "io"
+import "parallel"
+pfor 0..10 -> i {
+    new sq = i * i
+}
+printf("%d\\n", sq)
+`),
+      "Variable 'sq' is not defined",
+    );
+  },
+});
+
+Deno.test({
+  name: "vec_* mutators need a mutable vector",
+  fn: () => {
+    for (
+      const call of ["vec_push(v, 2)", "vec_clear(v)", "vec_reserve(v, 8)"]
+    ) {
+      assertStringIncludes(
+        semanticErrors(`import "vec"
+new v: int[..] = [1]
+${call}
+`),
+        "Cannot assign to immutable variable 'v'",
+      );
+    }
+    assertStringIncludes(
+      semanticErrors(`import "vec"
+fn fill(v: int[..]) {
+    vec_push(v, 7)
+}
+`),
+      "Cannot assign to immutable variable 'v'",
+    );
+  },
+});
+
+Deno.test({
+  name: "region rejects returning memory it is about to release",
+  fn: () => {
+    for (
+      const value of ["strcat(a, b)", "str_slice(a, 0, 1)", "slice(a, 0, 1)"]
+    ) {
+      assertStringIncludes(
+        semanticErrors(`import "arena"
+import "string"
+fn join(a: string, b: string): string {
+    region {
+        return ${value}
+    }
+    return a
+}
+`),
+        "Cannot return a string, pointer or view from inside a 'region'",
+      );
+    }
+    assertEquals(
+      semanticErrors(`import "arena"
+import "string"
+fn size(a: string, b: string): i64 {
+    region {
+        return str_length(strcat(a, b))
+    }
+    return 0
+}
+`),
+      "",
+    );
+  },
+});